@@ -0,0 +1,223 @@
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "tester.h"
+
+/*
+ * malloc/free interposer, linked in with
+ *   -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc
+ * so every call from libft.a (and from the tests) goes through the
+ * __wrap_* functions below. Tracking is only on between alloc_begin()
+ * and alloc_end(), i.e. while a test function runs.
+ */
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void  __real_free(void *ptr);
+
+/* Live allocations: open addressing keyed by pointer, bounded probing.
+ * Entries from earlier tests are told apart by their generation, so
+ * starting a test is O(1) instead of clearing the table. */
+#define ALLOC_TABLE_BITS  22
+#define ALLOC_TABLE_SIZE  (1UL << ALLOC_TABLE_BITS)
+#define ALLOC_MAX_PROBE   64
+
+typedef struct {
+    void *ptr;
+    size_t size;
+    unsigned gen;
+} t_alloc_entry;
+
+static t_alloc_entry *g_table = NULL;
+static unsigned g_gen = 0;
+static int g_tracking = 0;
+static t_alloc_stats g_cur;
+static size_t g_live_bytes = 0;
+static long g_live_blocks = 0;
+
+/* Failure injection: the g_fail_at-th allocation of a test returns NULL */
+static long g_fail_at = 0;
+static long g_attempts = 0;
+
+static size_t slot_of(const void *p) {
+    uint64_t h = ((uint64_t)(uintptr_t)p >> 4) * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(h >> (64 - ALLOC_TABLE_BITS));
+}
+
+/* Lazily map the table; pages are only committed once touched */
+static int table_ready(void) {
+    if (!g_table) {
+        void *p = mmap(NULL, ALLOC_TABLE_SIZE * sizeof(t_alloc_entry), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (p == MAP_FAILED)
+            return 0;
+        g_table = p;
+    }
+    return 1;
+}
+
+static void track_alloc(void *p, size_t size) {
+    g_cur.allocs++;
+    g_cur.bytes += size;
+    if (!table_ready()) {
+        g_cur.untracked++;
+        return;
+    }
+    size_t slot = slot_of(p);
+    for (int i = 0; i < ALLOC_MAX_PROBE; i++) {
+        t_alloc_entry *e = &g_table[(slot + i) & (ALLOC_TABLE_SIZE - 1)];
+        if (e->ptr == NULL || e->gen != g_gen) {
+            e->ptr = p;
+            e->size = size;
+            e->gen = g_gen;
+            g_live_bytes += size;
+            g_live_blocks++;
+            if (g_live_bytes > g_cur.peak)
+                g_cur.peak = g_live_bytes;
+            return;
+        }
+    }
+    g_cur.untracked++;
+}
+
+/* Forget `p`; pointers allocated outside the current test are ignored */
+static void track_free(void *p) {
+    g_cur.frees++;
+    if (!g_table)
+        return;
+    size_t slot = slot_of(p);
+    for (int i = 0; i < ALLOC_MAX_PROBE; i++) {
+        t_alloc_entry *e = &g_table[(slot + i) & (ALLOC_TABLE_SIZE - 1)];
+        if (e->ptr == NULL)
+            return;
+        if (e->ptr == p && e->gen == g_gen) {
+            e->gen = g_gen - 1;
+            g_live_bytes -= e->size;
+            g_live_blocks--;
+            return;
+        }
+    }
+}
+
+/* A signal that must not interrupt the allocator (the in-process
+ * deadline) waits here until the outermost wrapper returns, so a test is
+ * never abandoned while malloc holds its lock */
+static volatile sig_atomic_t g_in_alloc = 0;
+static volatile sig_atomic_t g_deferred = 0;
+
+static void alloc_enter(void) {
+    g_in_alloc++;
+}
+
+static void alloc_leave(void) {
+    if (--g_in_alloc == 0 && g_deferred) {
+        int sig = g_deferred;
+        g_deferred = 0;
+        raise(sig);
+    }
+}
+
+/* True while a wrapper is inside the real allocator, e.g. after a test
+ * faulted in malloc and was jumped out of */
+int alloc_busy(void) {
+    return g_in_alloc != 0;
+}
+
+/* Called from a signal handler: 1 if `sig` was put off until the
+ * allocator returns, 0 if the handler may go ahead */
+int alloc_defer(int sig) {
+    if (!g_in_alloc)
+        return 0;
+    g_deferred = sig;
+    return 1;
+}
+
+/* True when the allocation being attempted is the one to fail */
+static int inject_failure(void) {
+    if (!g_tracking || !g_fail_at || ++g_attempts != g_fail_at)
+        return 0;
+    g_cur.failed++;
+    return 1;
+}
+
+void *__wrap_malloc(size_t size) {
+    if (inject_failure())
+        return NULL;
+    alloc_enter();
+    void *p = __real_malloc(size);
+    if (g_tracking && p) {
+        g_tracking = 0;
+        track_alloc(p, size);
+        g_tracking = 1;
+    }
+    alloc_leave();
+    return p;
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    if (inject_failure())
+        return NULL;
+    alloc_enter();
+    void *p = __real_calloc(count, size);
+    if (g_tracking && p) {
+        g_tracking = 0;
+        track_alloc(p, count * size);
+        g_tracking = 1;
+    }
+    alloc_leave();
+    return p;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    if (inject_failure())
+        return NULL;
+    alloc_enter();
+    void *p = __real_realloc(ptr, size);
+    if (g_tracking && p) {
+        g_tracking = 0;
+        if (ptr)
+            track_free(ptr);
+        track_alloc(p, size);
+        g_tracking = 1;
+    }
+    alloc_leave();
+    return p;
+}
+
+void __wrap_free(void *ptr) {
+    alloc_enter();
+    if (g_tracking && ptr) {
+        g_tracking = 0;
+        track_free(ptr);
+        g_tracking = 1;
+    }
+    __real_free(ptr);
+    alloc_leave();
+}
+
+/* Start counting allocations for a new test */
+void alloc_begin(void) {
+    memset(&g_cur, 0, sizeof(g_cur));
+    g_live_bytes = 0;
+    g_live_blocks = 0;
+    g_attempts = 0;
+    g_gen += 2;
+    g_tracking = 1;
+}
+
+/* Make the n-th allocation of every following test fail; 0 turns it off */
+void alloc_fail_at(long n) {
+    g_fail_at = n;
+}
+
+/* Stop counting; whatever is still live has leaked */
+void alloc_end(t_alloc_stats *out) {
+    g_tracking = 0;
+    g_cur.leaked_blocks = g_live_blocks;
+    g_cur.leaked_bytes = g_live_bytes;
+    if (out)
+        *out = g_cur;
+}
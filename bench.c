@@ -0,0 +1,580 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "tester.h"
+
+/* Sweep parameters */
+#define BENCH_MIN_SIZE   8
+#define BENCH_WARMUP     3
+#define BENCH_MAX_REPS   51
+#define BENCH_MIN_REPS   5
+#define BENCH_BATCH      (64 << 10)   /* bytes processed per timed sample */
+#define BENCH_BUDGET_NS  50000000L    /* time spent per size/alignment/impl */
+
+/* Vectorization report: throughput is classified at an L1-resident size
+ * and compared with libc at a size no cache holds */
+#define VEC_L1_SIZE      (16 << 10)
+#define VEC_MEM_SIZE     (64UL << 20)
+#define VEC_WORD_MIN     2.5          /* bytes/cycle above a byte loop's reach */
+#define VEC_SIMD_MIN     17.0         /* bytes/cycle above two 8-byte accesses a cycle */
+#define VEC_ALIGN_SLOW   0.5          /* misaligned/aligned below this is flagged */
+#define VEC_CALIB_OPS    (1L << 23)
+
+static const size_t g_alignments[] = { 0, 1, 3 };
+#define NALIGNMENTS (int)(sizeof(g_alignments) / sizeof(g_alignments[0]))
+
+/* Defeats dead-code elimination of pure calls */
+static volatile size_t g_sink;
+
+/* One benchmarked function: both implementations share a signature */
+typedef size_t (*t_bench_fn)(char *dst, const char *src, size_t n);
+
+typedef struct {
+    const char *name;
+    void (*prepare)(char *dst, char *src, size_t n);
+    t_bench_fn ft;
+    t_bench_fn libc;
+} t_bench;
+
+/* Buffer setup: what each function needs to see to process all n bytes */
+static void prep_bytes(char *dst, char *src, size_t n) {
+    memset(src, 'a', n);
+    memset(dst, 'a', n);
+}
+
+static void prep_string(char *dst, char *src, size_t n) {
+    memset(src, 'a', n);
+    src[n - 1] = '\0';
+    memset(dst, 'a', n);
+    dst[n - 1] = '\0';
+}
+
+static void prep_last_byte(char *dst, char *src, size_t n) {
+    prep_string(dst, src, n);
+    if (n >= 2)
+        src[n - 2] = 'z';
+}
+
+static void prep_first_byte(char *dst, char *src, size_t n) {
+    prep_string(dst, src, n);
+    src[0] = 'z';
+}
+
+/* Wrappers giving every function the t_bench_fn signature */
+static size_t ft_memset_b(char *d, const char *s, size_t n) { (void)s; ft_memset(d, 'x', n); return 0; }
+static size_t lc_memset_b(char *d, const char *s, size_t n) { (void)s; memset(d, 'x', n); return 0; }
+static size_t ft_bzero_b(char *d, const char *s, size_t n) { (void)s; ft_bzero(d, n); return 0; }
+static size_t lc_bzero_b(char *d, const char *s, size_t n) { (void)s; bzero(d, n); return 0; }
+static size_t ft_memcpy_b(char *d, const char *s, size_t n) { ft_memcpy(d, s, n); return 0; }
+static size_t lc_memcpy_b(char *d, const char *s, size_t n) { memcpy(d, s, n); return 0; }
+static size_t ft_memmove_b(char *d, const char *s, size_t n) { ft_memmove(d, s, n); return 0; }
+static size_t lc_memmove_b(char *d, const char *s, size_t n) { memmove(d, s, n); return 0; }
+static size_t ft_memchr_b(char *d, const char *s, size_t n) { (void)d; return (size_t)ft_memchr(s, 'z', n); }
+static size_t lc_memchr_b(char *d, const char *s, size_t n) { (void)d; return (size_t)memchr(s, 'z', n); }
+static size_t ft_memcmp_b(char *d, const char *s, size_t n) { return (size_t)ft_memcmp(d, s, n); }
+static size_t lc_memcmp_b(char *d, const char *s, size_t n) { return (size_t)memcmp(d, s, n); }
+static size_t ft_strlen_b(char *d, const char *s, size_t n) { (void)d; (void)n; return ft_strlen(s); }
+static size_t lc_strlen_b(char *d, const char *s, size_t n) { (void)d; (void)n; return strlen(s); }
+static size_t ft_strchr_b(char *d, const char *s, size_t n) { (void)d; (void)n; return (size_t)ft_strchr(s, 'z'); }
+static size_t lc_strchr_b(char *d, const char *s, size_t n) { (void)d; (void)n; return (size_t)strchr(s, 'z'); }
+static size_t ft_strrchr_b(char *d, const char *s, size_t n) { (void)d; (void)n; return (size_t)ft_strrchr(s, 'z'); }
+static size_t lc_strrchr_b(char *d, const char *s, size_t n) { (void)d; (void)n; return (size_t)strrchr(s, 'z'); }
+static size_t ft_strncmp_b(char *d, const char *s, size_t n) { return (size_t)ft_strncmp(d, s, n); }
+static size_t lc_strncmp_b(char *d, const char *s, size_t n) { return (size_t)strncmp(d, s, n); }
+
+static const t_bench g_benches[] = {
+    { "ft_memset",  prep_bytes,      ft_memset_b,  lc_memset_b },
+    { "ft_bzero",   prep_bytes,      ft_bzero_b,   lc_bzero_b },
+    { "ft_memcpy",  prep_bytes,      ft_memcpy_b,  lc_memcpy_b },
+    { "ft_memmove", prep_bytes,      ft_memmove_b, lc_memmove_b },
+    { "ft_memchr",  prep_last_byte,  ft_memchr_b,  lc_memchr_b },
+    { "ft_memcmp",  prep_bytes,      ft_memcmp_b,  lc_memcmp_b },
+    { "ft_strlen",  prep_string,     ft_strlen_b,  lc_strlen_b },
+    { "ft_strchr",  prep_last_byte,  ft_strchr_b,  lc_strchr_b },
+    { "ft_strrchr", prep_first_byte, ft_strrchr_b, lc_strrchr_b },
+    { "ft_strncmp", prep_string,     ft_strncmp_b, lc_strncmp_b },
+};
+#define NBENCHES (int)(sizeof(g_benches) / sizeof(g_benches[0]))
+
+/* Monotonic clock in nanoseconds */
+long long bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Median and p99 of `n` samples (sorts them in place) */
+void bench_summarize(double *samples, int n, double *median, double *p99) {
+    qsort(samples, n, sizeof(double), cmp_double);
+    *median = samples[n / 2];
+    int idx = (int)(0.99 * n + 0.999999) - 1;
+    *p99 = samples[idx < 0 ? 0 : (idx >= n ? n - 1 : idx)];
+}
+
+/* Time `fn` on n bytes: warm-up, then per-byte cost of repeated batches */
+static void time_impl(t_bench_fn fn, char *dst, const char *src, size_t n,
+                      double *median, double *p99) {
+    double samples[BENCH_MAX_REPS];
+    size_t iters = n >= BENCH_BATCH ? 1 : BENCH_BATCH / n;
+    size_t sink = 0;
+
+    long long t0 = bench_now_ns();
+    for (int w = 0; w < BENCH_WARMUP; w++)
+        for (size_t i = 0; i < iters; i++)
+            sink += fn(dst, src, n);
+    long long per_batch = (bench_now_ns() - t0) / BENCH_WARMUP + 1;
+
+    int reps = (int)(BENCH_BUDGET_NS / per_batch);
+    if (reps > BENCH_MAX_REPS)
+        reps = BENCH_MAX_REPS;
+    if (reps < BENCH_MIN_REPS)
+        reps = BENCH_MIN_REPS;
+
+    for (int r = 0; r < reps; r++) {
+        long long start = bench_now_ns();
+        for (size_t i = 0; i < iters; i++)
+            sink += fn(dst, src, n);
+        samples[r] = (double)(bench_now_ns() - start) / ((double)iters * n);
+    }
+    g_sink = sink;
+    bench_summarize(samples, reps, median, p99);
+}
+
+/* Counters of one extra batch of `fn`, per byte processed */
+static void count_impl(t_bench_fn fn, char *dst, const char *src, size_t n, double *per_byte) {
+    size_t iters = n >= BENCH_BATCH ? 1 : BENCH_BATCH / n;
+    size_t sink = 0;
+    t_perf_stats p;
+
+    perf_begin();
+    for (size_t i = 0; i < iters; i++)
+        sink += fn(dst, src, n);
+    perf_end(&p);
+    g_sink = sink;
+    for (int i = 0; i < PERF_NCOUNTERS; i++)
+        per_byte[i] = p.valid && p.counts[i] >= 0 ? (double)p.counts[i] / ((double)iters * n) : -1;
+}
+
+/* One counter column; "-" for a counter the CPU lacks */
+static void print_rate(double v, double scale, int width) {
+    if (v < 0)
+        printf(" %*s", width, "-");
+    else
+        printf(" %*.3f", width, v * scale);
+}
+
+/* Nanoseconds per CPU cycle, timed on a chain of dependent instructions
+ * of known latency: imul (3 cycles) on x86-64, since recent cores fold
+ * chains of immediate adds, and register adds (1 cycle) on AArch64.
+ * 0 where there is no inline assembly for the CPU */
+static double cycle_ns(void) {
+#if defined(__x86_64__) || defined(__aarch64__)
+# if defined(__x86_64__)
+    const double latency = 3;
+# else
+    const double latency = 1;
+# endif
+    double best = 0;
+    for (int run = 0; run < 5; run++) {
+        unsigned long x = 3;
+        unsigned long y = 5;
+        long long start = bench_now_ns();
+        for (long i = 0; i < VEC_CALIB_OPS / 16; i++) {
+# if defined(__x86_64__)
+            __asm__ volatile(".rept 16\n\timul %1, %0\n\t.endr" : "+r"(x) : "r"(y));
+# else
+            __asm__ volatile(".rept 16\n\tadd %0, %0, %1\n\t.endr" : "+r"(x) : "r"(y));
+# endif
+        }
+        double ns = (double)(bench_now_ns() - start) / VEC_CALIB_OPS / latency;
+        g_sink = x;
+        if (best == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+#else
+    return 0;
+#endif
+}
+
+/* Page-aligned buffer large enough for the biggest size plus misalignment */
+static char *bench_alloc(size_t size) {
+    void *p = NULL;
+    if (posix_memalign(&p, 4096, size + 64) != 0)
+        return NULL;
+    return p;
+}
+
+/* Print a byte count as 8B, 4KiB, 64MiB, 1GiB... */
+void format_size(size_t n, char *buf, size_t len) {
+    if (n >= (1UL << 30) && n % (1UL << 30) == 0)
+        snprintf(buf, len, "%zuGiB", n >> 30);
+    else if (n >= (1UL << 20) && n % (1UL << 20) == 0)
+        snprintf(buf, len, "%zuMiB", n >> 20);
+    else if (n >= 1024 && n % 1024 == 0)
+        snprintf(buf, len, "%zuKiB", n >> 10);
+    else
+        snprintf(buf, len, "%zuB", n);
+}
+
+/* Benchmark one function over the whole sweep; runs in its own child */
+static int bench_function(const t_bench *b, const t_bench_config *cfg, FILE *csv) {
+    char *dst = bench_alloc(cfg->max_size);
+    char *src = bench_alloc(cfg->max_size);
+    if (!dst || !src)
+        return 1;
+
+    for (size_t n = BENCH_MIN_SIZE; n <= cfg->max_size; n *= 2) {
+        for (int a = 0; a < NALIGNMENTS; a++) {
+            size_t off = g_alignments[a];
+            double ft_med, ft_p99, lc_med, lc_p99;
+            double ft_pc[PERF_NCOUNTERS], lc_pc[PERF_NCOUNTERS];
+            char size_str[16];
+
+            b->prepare(dst + off, src + off, n);
+            time_impl(b->ft, dst + off, src + off, n, &ft_med, &ft_p99);
+            b->prepare(dst + off, src + off, n);
+            time_impl(b->libc, dst + off, src + off, n, &lc_med, &lc_p99);
+
+            double ratio = lc_med > 0 ? ft_med / lc_med : 0;
+            const char *color = ratio <= 2 ? GREEN : (ratio <= 10 ? YELLOW : RED);
+            format_size(n, size_str, sizeof(size_str));
+            printf("  %-10s %8s %5zu %10.4f %10.4f %10.4f %10.4f %s%8.1fx" RESET,
+                   b->name, size_str, off, ft_med, ft_p99, lc_med, lc_p99, color, ratio);
+            if (cfg->perf) {
+                b->prepare(dst + off, src + off, n);
+                count_impl(b->ft, dst + off, src + off, n, ft_pc);
+                b->prepare(dst + off, src + off, n);
+                count_impl(b->libc, dst + off, src + off, n, lc_pc);
+                double ipc = ft_pc[PERF_CYCLES] > 0 && ft_pc[PERF_INSTRUCTIONS] >= 0
+                             ? ft_pc[PERF_INSTRUCTIONS] / ft_pc[PERF_CYCLES] : -1;
+                print_rate(ft_pc[PERF_INSTRUCTIONS], 1, 8);
+                print_rate(ipc, 1, 6);
+                print_rate(ft_pc[PERF_BRANCH_MISSES], 1024, 9);
+                print_rate(ft_pc[PERF_L1D_MISSES], 1024, 9);
+                print_rate(lc_pc[PERF_INSTRUCTIONS], 1, 10);
+            }
+            printf("\n");
+            if (csv) {
+                fprintf(csv, "%s,%zu,%zu,%.6f,%.6f,%.6f,%.6f,%.4f",
+                        b->name, n, off, ft_med, ft_p99, lc_med, lc_p99, ratio);
+                if (cfg->perf) {
+                    for (int i = 0; i < PERF_NCOUNTERS; i++)
+                        fprintf(csv, ",%.6f", ft_pc[i]);
+                    for (int i = 0; i < PERF_NCOUNTERS; i++)
+                        fprintf(csv, ",%.6f", lc_pc[i]);
+                }
+                fprintf(csv, "\n");
+                fflush(csv);
+            }
+            fflush(stdout);
+        }
+    }
+    free(dst);
+    free(src);
+    return 0;
+}
+
+/* Classify one function from its L1 throughput and compare it with libc
+ * out of cache; runs in its own child */
+static int vector_function(const t_bench *b, size_t mem_size, double ns_per_cycle) {
+    char *dst = bench_alloc(mem_size);
+    char *src = bench_alloc(mem_size);
+    double bpc[NALIGNMENTS];
+    double med, p99, lc_med, ft_mem, lc_mem;
+
+    if (!dst || !src)
+        return 1;
+    /* Bytes per cycle (or per ns without a cycle estimate) at each offset */
+    double unit = ns_per_cycle > 0 ? ns_per_cycle : 1;
+    for (int a = 0; a < NALIGNMENTS; a++) {
+        size_t off = g_alignments[a];
+        b->prepare(dst + off, src + off, VEC_L1_SIZE);
+        time_impl(b->ft, dst + off, src + off, VEC_L1_SIZE, &med, &p99);
+        bpc[a] = med > 0 ? unit / med : 0;
+    }
+    b->prepare(dst, src, VEC_L1_SIZE);
+    time_impl(b->libc, dst, src, VEC_L1_SIZE, &lc_med, &p99);
+    b->prepare(dst, src, mem_size);
+    time_impl(b->ft, dst, src, mem_size, &ft_mem, &p99);
+    b->prepare(dst, src, mem_size);
+    time_impl(b->libc, dst, src, mem_size, &lc_mem, &p99);
+
+    const char *class = "byte-wise";
+    const char *color = RED;
+    if (ns_per_cycle <= 0) {
+        class = "unknown";
+        color = "";
+    } else if (bpc[0] >= VEC_SIMD_MIN) {
+        class = "SIMD";
+        color = GREEN;
+    } else if (bpc[0] >= VEC_WORD_MIN) {
+        class = "word-at-a-time";
+        color = YELLOW;
+    }
+    double worst = bpc[0];
+    for (int a = 1; a < NALIGNMENTS; a++)
+        worst = bpc[a] < worst ? bpc[a] : worst;
+    double bandwidth = ft_mem > 0 ? lc_mem / ft_mem : 0;
+    printf("  %-10s", b->name);
+    for (int a = 0; a < NALIGNMENTS; a++)
+        printf(" %8.2f", bpc[a]);
+    printf(" %8.2f  %s%-15s" RESET " %s%5.0f%%" RESET " %7.2f GB/s %s\n",
+           lc_med > 0 ? unit / lc_med : 0, color, class,
+           bandwidth >= 0.8 ? GREEN : (bandwidth >= 0.3 ? YELLOW : RED), bandwidth * 100,
+           ft_mem > 0 ? 1 / ft_mem : 0,
+           worst < bpc[0] * VEC_ALIGN_SLOW ? YELLOW "alignment-sensitive" RESET : "");
+    fflush(stdout);
+    free(dst);
+    free(src);
+    return 0;
+}
+
+/* Classify the mem* functions and ft_strlen as byte-wise, word-at-a-time
+ * or SIMD from measured throughput, and estimate how much of libc's
+ * out-of-cache bandwidth each reaches */
+int run_vector_report(const t_bench_config *cfg) {
+    static const char *names[] = {
+        "ft_memset", "ft_bzero", "ft_memcpy", "ft_memmove", "ft_memchr", "ft_memcmp", "ft_strlen"
+    };
+    size_t mem_size = cfg->max_size < VEC_MEM_SIZE ? cfg->max_size : VEC_MEM_SIZE;
+    double ns_per_cycle = cycle_ns();
+    char l1[16];
+    char mem[16];
+    int crashed = 0;
+
+    if (mem_size < VEC_L1_SIZE)
+        mem_size = VEC_L1_SIZE;
+    format_size(VEC_L1_SIZE, l1, sizeof(l1));
+    format_size(mem_size, mem, sizeof(mem));
+    printf(BOLD CYAN "\n=== Vectorization report ===" RESET "\n");
+    if (ns_per_cycle > 0)
+        printf("Throughput in bytes/cycle at %s (1 cycle = %.3f ns, %.2f GHz). Below %.1f is\n"
+               "byte-wise, below %.1f word-at-a-time, above that SIMD. Bandwidth is the\n"
+               "share of libc's throughput at %s.\n",
+               l1, ns_per_cycle, 1 / ns_per_cycle, VEC_WORD_MIN, VEC_SIMD_MIN, mem);
+    else
+        printf("No cycle estimate on this CPU: throughput in bytes/ns at %s, not classified.\n"
+               "Bandwidth is the share of libc's throughput at %s.\n", l1, mem);
+    printf(BOLD "  %-10s %8s %8s %8s %8s  %-15s %6s %12s" RESET "\n",
+           "function", "align 0", "align 1", "align 3", "libc", "class", "bw", "ft @mem");
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        const t_bench *b = NULL;
+        for (int j = 0; j < NBENCHES; j++) {
+            if (strcmp(g_benches[j].name, names[i]) == 0)
+                b = &g_benches[j];
+        }
+        if (!b || (cfg->only && strcmp(cfg->only, b->name) != 0))
+            continue;
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0)
+            exit(vector_function(b, mem_size, ns_per_cycle));
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+            perror("libft_test: vector");
+            crashed++;
+        } else if (WIFSIGNALED(status)) {
+            printf(RED "  %-10s crashed: %s" RESET "\n", b->name, strsignal(WTERMSIG(status)));
+            crashed++;
+        }
+    }
+    return crashed ? 1 : 0;
+}
+
+/* Benchmark every function against libc; each function runs in a child
+ * so a crashing implementation only loses its own rows */
+int run_benchmarks(const t_bench_config *cfg) {
+    t_bench_config local = *cfg;
+    FILE *csv = NULL;
+
+    /* Without counters the table is the plain clock_gettime() one */
+    if (local.perf && !perf_available()) {
+        fprintf(stderr, "libft_test: hardware counters unavailable, --perf ignored\n");
+        local.perf = 0;
+    }
+    cfg = &local;
+
+    if (cfg->csv_path) {
+        csv = fopen(cfg->csv_path, "w");
+        if (!csv) {
+            perror(cfg->csv_path);
+            return 2;
+        }
+        fprintf(csv, "function,size,align,ft_median_ns_per_byte,ft_p99_ns_per_byte,"
+                     "libc_median_ns_per_byte,libc_p99_ns_per_byte,ratio");
+        if (cfg->perf)
+            fprintf(csv, ",ft_cycles_per_byte,ft_instructions_per_byte,ft_branch_misses_per_byte,"
+                         "ft_l1d_misses_per_byte,ft_llc_misses_per_byte,libc_cycles_per_byte,"
+                         "libc_instructions_per_byte,libc_branch_misses_per_byte,"
+                         "libc_l1d_misses_per_byte,libc_llc_misses_per_byte");
+        fprintf(csv, "\n");
+        fflush(csv);
+    }
+
+    printf(BOLD CYAN "\n=== Benchmarks (ns/byte, lower is better) ===" RESET "\n");
+    printf(BOLD "  %-10s %8s %5s %10s %10s %10s %10s %9s",
+           "function", "size", "align", "ft med", "ft p99", "libc med", "libc p99", "ft/libc");
+    if (cfg->perf)
+        printf(" %8s %6s %9s %9s %10s", "ft ins/B", "ft IPC", "brmiss/KB", "L1dmis/KB", "libc ins/B");
+    printf(RESET "\n");
+
+    int crashed = 0;
+    for (int i = 0; i < NBENCHES; i++) {
+        if (cfg->only && strcmp(cfg->only, g_benches[i].name) != 0)
+            continue;
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0)
+            exit(bench_function(&g_benches[i], cfg, csv));
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+            perror("libft_test: bench");
+            crashed++;
+        } else if (WIFSIGNALED(status)) {
+            printf(RED "  %-10s crashed: %s" RESET "\n",
+                   g_benches[i].name, strsignal(WTERMSIG(status)));
+            crashed++;
+        }
+    }
+    if (csv)
+        fclose(csv);
+    return crashed ? 1 : 0;
+}
+
+/* Compiler x flags matrix: the --csv files of one --bench per build of
+ * libft, compared at a few sizes (make bench-matrix) */
+#define MATRIX_MAX_CONFIGS 16
+#define MATRIX_LIBC_CLOSE  1.1        /* within 10% of libc: likely vectorized or a libc call */
+
+static const size_t g_matrix_sizes[] = { 64, 4096, 1UL << 20, 64UL << 20 };
+#define NMATRIX_SIZES (int)(sizeof(g_matrix_sizes) / sizeof(g_matrix_sizes[0]))
+
+typedef struct {
+    char label[32];
+    double ft[NBENCHES][NMATRIX_SIZES];     /* median ns/byte, 0 if not measured */
+    double libc[NBENCHES][NMATRIX_SIZES];
+} t_matrix_config;
+
+/* "bench_matrix/gcc-O2.csv" -> "gcc-O2" */
+static void matrix_label(const char *path, char *buf, size_t len) {
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    size_t n = strcspn(base, ".");
+    snprintf(buf, len, "%.*s", (int)n, base);
+}
+
+/* Keep the aligned rows at the matrix sizes of one --csv file */
+static int read_bench_csv(const char *path, t_matrix_config *c) {
+    FILE *f = fopen(path, "r");
+    char line[512];
+    char name[32];
+    size_t n, align;
+    double ft, ft_p99, libc;
+
+    if (!f) {
+        perror(path);
+        return 0;
+    }
+    memset(c, 0, sizeof(*c));
+    matrix_label(path, c->label, sizeof(c->label));
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%31[^,],%zu,%zu,%lf,%lf,%lf", name, &n, &align, &ft, &ft_p99, &libc) != 6
+            || align != 0)
+            continue;
+        for (int b = 0; b < NBENCHES; b++) {
+            for (int s = 0; s < NMATRIX_SIZES && strcmp(name, g_benches[b].name) == 0; s++) {
+                if (g_matrix_sizes[s] == n) {
+                    c->ft[b][s] = ft;
+                    c->libc[b][s] = libc;
+                }
+            }
+        }
+    }
+    fclose(f);
+    return 1;
+}
+
+/* One row per function and size, one GB/s column per build, the fastest
+ * in green; the last line ranks builds by geometric mean throughput */
+int run_bench_matrix(char **paths, int n) {
+    static t_matrix_config configs[MATRIX_MAX_CONFIGS];
+    double log_sum[MATRIX_MAX_CONFIGS] = { 0 };
+    int rows[MATRIX_MAX_CONFIGS] = { 0 };
+    int nconfigs = 0;
+
+    if (n > MATRIX_MAX_CONFIGS) {
+        fprintf(stderr, "libft_test: at most %d builds in a matrix\n", MATRIX_MAX_CONFIGS);
+        return 2;
+    }
+    for (int i = 0; i < n; i++) {
+        if (!read_bench_csv(paths[i], &configs[nconfigs]))
+            return 2;
+        nconfigs++;
+    }
+
+    printf(BOLD CYAN "\n=== Build matrix (GB/s at align 0, higher is better) ===" RESET "\n");
+    printf(BOLD "  %-10s %8s", "function", "size");
+    for (int c = 0; c < nconfigs; c++)
+        printf(" %10s", configs[c].label);
+    printf(" %10s" RESET "\n", "libc");
+    for (int b = 0; b < NBENCHES; b++) {
+        for (int s = 0; s < NMATRIX_SIZES; s++) {
+            double best = 0;
+            double libc = 0;
+            for (int c = 0; c < nconfigs; c++) {
+                double v = configs[c].ft[b][s];
+                if (v > 0 && (best == 0 || v < best))
+                    best = v;
+                if (libc == 0)
+                    libc = configs[c].libc[b][s];
+            }
+            if (best == 0)
+                continue;
+            char size_str[16];
+            format_size(g_matrix_sizes[s], size_str, sizeof(size_str));
+            printf("  %-10s %8s", g_benches[b].name, size_str);
+            for (int c = 0; c < nconfigs; c++) {
+                double v = configs[c].ft[b][s];
+                if (v <= 0) {
+                    printf(" %10s", "-");
+                    continue;
+                }
+                log_sum[c] += log(1 / v);
+                rows[c]++;
+                printf(" %s%9.2f%s" RESET, v == best ? GREEN : "", 1 / v,
+                       libc > 0 && v <= libc * MATRIX_LIBC_CLOSE ? "*" : " ");
+            }
+            if (libc > 0)
+                printf(" %10.2f\n", 1 / libc);
+            else
+                printf(" %10s\n", "-");
+        }
+    }
+
+    int winner = -1;
+    printf(BOLD "  %-10s %8s", "geomean", "");
+    for (int c = 0; c < nconfigs; c++) {
+        double g = rows[c] > 0 ? exp(log_sum[c] / rows[c]) : 0;
+        printf(" %10.2f", g);
+        if (rows[c] > 0 && (winner < 0 || log_sum[c] / rows[c] > log_sum[winner] / rows[winner]))
+            winner = c;
+    }
+    printf(RESET "\n* within %.0f%% of libc: the compiler vectorized the loop or called libc\n",
+           (MATRIX_LIBC_CLOSE - 1) * 100);
+    if (winner >= 0)
+        printf(GREEN BOLD "Fastest build overall: %s" RESET "\n", configs[winner].label);
+    return 0;
+}
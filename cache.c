@@ -0,0 +1,404 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <elf.h>
+#include <sys/stat.h>
+#include "tester.h"
+
+/*
+ * On-disk result cache for --cache. A test's key hashes the version of
+ * the suite, the test itself, and the libft.a members its function needs:
+ * the objects defining it and any function the test declares it uses
+ * (REGISTER_TEST_USES), plus every object those reference, followed
+ * transitively through undefined symbols. Changing ft_split.c then only
+ * re-runs the tests of the functions whose objects reach ft_split.o.
+ */
+
+/* Hash of the tester sources, set by the Makefile */
+#ifndef SUITE_VERSION
+# define SUITE_VERSION __DATE__ " " __TIME__
+#endif
+#ifndef LIBFT_ARCHIVE
+# define LIBFT_ARCHIVE "libft/libft.a"
+#endif
+
+#define CACHE_MAX_ENTRIES 4096
+
+/* One object file of libft.a and the symbols it defines and needs */
+typedef struct {
+    uint64_t hash;
+    char **defines;
+    int ndefines;
+    char **needs;
+    int nneeds;
+} t_member;
+
+/* One cached result */
+typedef struct {
+    uint64_t key;
+    t_outcome outcome;
+    int status;
+    long long duration_ns;
+    t_alloc_stats alloc;
+    char *output;
+    int used;
+} t_cache_entry;
+
+static int g_enabled = 0;
+static const char *g_path = NULL;
+static uint64_t g_suite = 0;
+static uint64_t g_archive = 0;
+static t_member *g_members = NULL;
+static int g_nmembers = 0;
+static t_cache_entry *g_entries = NULL;
+static int g_nentries = 0;
+static int g_dirty = 0;
+
+/* 64-bit FNV-1a, continuing from `h` */
+static uint64_t fnv(uint64_t h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+#define FNV_INIT 0xcbf29ce484222325ULL
+
+static void add_name(char ***list, int *n, const char *name) {
+    char **grown = realloc(*list, (*n + 1) * sizeof(**list));
+    if (!grown)
+        return;
+    *list = grown;
+    if ((grown[*n] = strdup(name)) != NULL)
+        (*n)++;
+}
+
+/* Record the global symbols a 64-bit ELF relocatable defines and needs.
+ * Anything else (LTO bitcode, 32-bit objects) leaves both lists empty. */
+static void read_symbols(t_member *m, const unsigned char *obj, size_t size) {
+    const Elf64_Ehdr *eh = (const void *)obj;
+
+    if (size < sizeof(*eh) || memcmp(eh->e_ident, ELFMAG, SELFMAG) != 0
+        || eh->e_ident[EI_CLASS] != ELFCLASS64 || eh->e_shentsize != sizeof(Elf64_Shdr)
+        || eh->e_shoff + (uint64_t)eh->e_shnum * sizeof(Elf64_Shdr) > size)
+        return;
+    const Elf64_Shdr *sh = (const void *)(obj + eh->e_shoff);
+    for (int s = 0; s < eh->e_shnum; s++) {
+        if (sh[s].sh_type != SHT_SYMTAB || sh[s].sh_link >= eh->e_shnum)
+            continue;
+        const Elf64_Shdr *strsh = &sh[sh[s].sh_link];
+        if (sh[s].sh_offset + sh[s].sh_size > size || strsh->sh_offset + strsh->sh_size > size)
+            continue;
+        const Elf64_Sym *sym = (const void *)(obj + sh[s].sh_offset);
+        const char *strtab = (const char *)obj + strsh->sh_offset;
+        size_t nsyms = sh[s].sh_size / sizeof(*sym);
+        for (size_t i = 1; i < nsyms; i++) {
+            int bind = ELF64_ST_BIND(sym[i].st_info);
+            if ((bind != STB_GLOBAL && bind != STB_WEAK) || sym[i].st_name >= strsh->sh_size)
+                continue;
+            const char *name = strtab + sym[i].st_name;
+            if (sym[i].st_shndx == SHN_UNDEF)
+                add_name(&m->needs, &m->nneeds, name);
+            else
+                add_name(&m->defines, &m->ndefines, name);
+        }
+    }
+}
+
+/* Split a GNU or BSD ar archive into members; returns 0 if unreadable */
+static int read_archive(const char *path) {
+    FILE *f = fopen(path, "rb");
+    unsigned char *data = NULL;
+    long size;
+
+    if (!f)
+        return 0;
+    if (fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < 8 || fseek(f, 0, SEEK_SET) != 0
+        || (data = malloc(size)) == NULL || fread(data, 1, size, f) != (size_t)size
+        || memcmp(data, "!<arch>\n", 8) != 0) {
+        fclose(f);
+        free(data);
+        return 0;
+    }
+    fclose(f);
+    g_archive = fnv(FNV_INIT, data, size);
+    for (long pos = 8; pos + 60 <= size; ) {
+        const char *hdr = (const char *)data + pos;
+        long len = strtol(hdr + 48, NULL, 10);
+        const unsigned char *body = data + pos + 60;
+        if (len < 0 || pos + 60 + len > size)
+            break;
+        pos += 60 + len + (len & 1);
+        /* The symbol index and the long-name table are not objects */
+        if (hdr[0] == '/' && (hdr[1] == ' ' || hdr[1] == '/' || hdr[1] == 'S'))
+            continue;
+        if (strncmp(hdr, "#1/", 3) == 0) {
+            long nlen = strtol(hdr + 3, NULL, 10);
+            if (nlen > len)
+                continue;
+            body += nlen;
+            len -= nlen;
+        }
+        t_member *grown = realloc(g_members, (g_nmembers + 1) * sizeof(*grown));
+        if (!grown)
+            break;
+        g_members = grown;
+        t_member *m = &g_members[g_nmembers++];
+        memset(m, 0, sizeof(*m));
+        m->hash = fnv(FNV_INIT, body, len);
+        read_symbols(m, body, len);
+    }
+    free(data);
+    return 1;
+}
+
+static int member_defining(const char *symbol) {
+    for (int i = 0; i < g_nmembers; i++) {
+        for (int d = 0; d < g_members[i].ndefines; d++) {
+            if (strcmp(g_members[i].defines[d], symbol) == 0)
+                return i;
+        }
+    }
+    return -1;
+}
+
+static void mark_reachable(int m, char *seen) {
+    if (seen[m])
+        return;
+    seen[m] = 1;
+    for (int n = 0; n < g_members[m].nneeds; n++) {
+        int dep = member_defining(g_members[m].needs[n]);
+        if (dep >= 0)
+            mark_reachable(dep, seen);
+    }
+}
+
+/* Mark the objects `function` needs; 0 if no object defines it */
+static int mark_function(const char *function, size_t len, char *seen) {
+    char name[128];
+    if (len >= sizeof(name))
+        return 0;
+    memcpy(name, function, len);
+    name[len] = '\0';
+    int m = member_defining(name);
+    if (m < 0)
+        return 0;
+    mark_reachable(m, seen);
+    return 1;
+}
+
+/* Hash of the code a test runs: the objects of its group's function and
+ * of the functions it uses, and everything they pull in. A name that is
+ * not a symbol makes it depend on the whole archive */
+static uint64_t code_hash(const t_test *t) {
+    char *seen = calloc(g_nmembers ? g_nmembers : 1, 1);
+    if (!seen)
+        return g_archive;
+    int known = mark_function(t->group->name, strlen(t->group->name), seen);
+    for (const char *p = t->uses; known && p && *p; ) {
+        size_t len = strcspn(p, " ");
+        if (len > 0)
+            known = mark_function(p, len, seen);
+        p += len + (p[len] == ' ');
+    }
+    if (!known) {
+        free(seen);
+        return g_archive;
+    }
+    uint64_t h = FNV_INIT;
+    for (int i = 0; i < g_nmembers; i++) {
+        if (seen[i])
+            h = fnv(h, &g_members[i].hash, sizeof(g_members[i].hash));
+    }
+    free(seen);
+    return h;
+}
+
+static uint64_t test_key(const t_test *t) {
+    uint64_t h = fnv(g_suite, t->group->name, strlen(t->group->name) + 1);
+    h = fnv(h, t->name, strlen(t->name) + 1);
+    h = fnv(h, &t->timeout_ms, sizeof(t->timeout_ms));
+    uint64_t code = code_hash(t);
+    return fnv(h, &code, sizeof(code));
+}
+
+/* Output is stored as hex so that any byte survives one line */
+static char *hex_decode(const char *s) {
+    size_t len = strlen(s) / 2;
+    char *out = malloc(len + 1);
+    if (!out)
+        return NULL;
+    for (size_t i = 0; i < len; i++) {
+        unsigned v;
+        if (sscanf(s + 2 * i, "%2x", &v) != 1)
+            v = '?';
+        out[i] = (char)v;
+    }
+    out[len] = '\0';
+    return out;
+}
+
+static void load_entries(FILE *f) {
+    char *line = NULL;
+    size_t cap = 0;
+    char version[32];
+
+    if (getline(&line, &cap, f) <= 0 || sscanf(line, "# suite %31s", version) != 1
+        || strtoull(version, NULL, 16) != g_suite) {
+        free(line);
+        return;
+    }
+    while (getline(&line, &cap, f) > 0 && g_nentries < CACHE_MAX_ENTRIES) {
+        t_cache_entry e = { 0 };
+        unsigned long long key;
+        int outcome;
+        int used = 0;
+        t_alloc_stats *a = &e.alloc;
+        if (sscanf(line, "%llx %d %d %lld %ld %ld %zu %zu %ld %zu %ld %ld %n", &key, &outcome,
+                   &e.status, &e.duration_ns, &a->allocs, &a->frees, &a->bytes, &a->peak,
+                   &a->leaked_blocks, &a->leaked_bytes, &a->untracked, &a->failed, &used) != 12
+            || outcome <= OUTCOME_PENDING || outcome > OUTCOME_TIMEOUT)
+            continue;
+        e.key = key;
+        e.outcome = (t_outcome)outcome;
+        line[strcspn(line, "\n")] = '\0';
+        if (strcmp(line + used, "-") != 0)
+            e.output = hex_decode(line + used);
+        t_cache_entry *grown = realloc(g_entries, (g_nentries + 1) * sizeof(*grown));
+        if (!grown)
+            break;
+        g_entries = grown;
+        g_entries[g_nentries++] = e;
+    }
+    free(line);
+}
+
+/* Turn the cache on for this run. It stays off, with a warning, if
+ * libft.a cannot be read or was rebuilt after libft_test was linked:
+ * the archive would then not be the code the tests run. */
+int cache_open(const char *path) {
+    struct stat lib;
+    struct stat exe;
+
+    if (stat(LIBFT_ARCHIVE, &lib) != 0 || !read_archive(LIBFT_ARCHIVE)) {
+        fprintf(stderr, "libft_test: cannot read %s, not using the cache\n", LIBFT_ARCHIVE);
+        return 0;
+    }
+    if (stat("/proc/self/exe", &exe) == 0 && lib.st_mtime > exe.st_mtime) {
+        fprintf(stderr, "libft_test: %s is newer than libft_test, not using the cache\n",
+                LIBFT_ARCHIVE);
+        return 0;
+    }
+    g_suite = fnv(FNV_INIT, SUITE_VERSION, strlen(SUITE_VERSION));
+    g_path = path;
+    g_enabled = 1;
+    FILE *f = fopen(path, "r");
+    if (f) {
+        load_entries(f);
+        fclose(f);
+    }
+    return 1;
+}
+
+/* Fill in a registered test from the cache; returns 1 on a hit */
+int cache_lookup(t_test *t) {
+    if (!g_enabled)
+        return 0;
+    uint64_t key = test_key(t);
+    for (int i = 0; i < g_nentries; i++) {
+        t_cache_entry *e = &g_entries[i];
+        if (e->key != key)
+            continue;
+        e->used = 1;
+        t->outcome = e->outcome;
+        t->status = e->status;
+        t->duration_ns = e->duration_ns;
+        t->alloc = e->alloc;
+        t->output = e->output ? strdup(e->output) : NULL;
+        t->cached = 1;
+        return 1;
+    }
+    return 0;
+}
+
+/* Remember a test that really ran. Timeouts depend on the machine's
+ * load, so they are always run again, and a sanitizer's report is not
+ * kept, so neither is its result */
+void cache_record(const t_test *t) {
+    if (!g_enabled || t->cached || t->outcome == OUTCOME_TIMEOUT
+        || t->outcome == OUTCOME_SANITIZER || t->outcome == OUTCOME_PENDING)
+        return;
+    t_cache_entry *grown = realloc(g_entries, (g_nentries + 1) * sizeof(*grown));
+    if (!grown)
+        return;
+    g_entries = grown;
+    t_cache_entry *e = &g_entries[g_nentries++];
+    e->key = test_key(t);
+    e->outcome = t->outcome;
+    e->status = t->status;
+    e->duration_ns = t->duration_ns;
+    e->alloc = t->alloc;
+    e->output = t->output ? strdup(t->output) : NULL;
+    e->used = 1;
+    g_dirty = 1;
+}
+
+static void write_entry(FILE *f, const t_cache_entry *e) {
+    const t_alloc_stats *a = &e->alloc;
+    fprintf(f, "%016llx %d %d %lld %ld %ld %zu %zu %ld %zu %ld %ld ",
+            (unsigned long long)e->key, (int)e->outcome, e->status, e->duration_ns,
+            a->allocs, a->frees, a->bytes, a->peak, a->leaked_blocks, a->leaked_bytes,
+            a->untracked, a->failed);
+    if (!e->output || !*e->output)
+        fputc('-', f);
+    for (const char *p = e->output; p && *p; p++)
+        fprintf(f, "%02x", (unsigned char)*p);
+    fputc('\n', f);
+}
+
+/* Write the cache back: this run's results first, then older ones up to
+ * CACHE_MAX_ENTRIES, newest first */
+void cache_close(void) {
+    if (!g_enabled)
+        return;
+    g_enabled = 0;
+    if (g_dirty) {
+        char tmp[4096];
+        snprintf(tmp, sizeof(tmp), "%s.tmp", g_path);
+        FILE *f = fopen(tmp, "w");
+        if (!f) {
+            perror(tmp);
+        } else {
+            int written = 0;
+            fprintf(f, "# suite %016llx\n", (unsigned long long)g_suite);
+            for (int pass = 1; pass >= 0; pass--) {
+                for (int i = g_nentries - 1; i >= 0 && written < CACHE_MAX_ENTRIES; i--) {
+                    if (g_entries[i].used == pass) {
+                        write_entry(f, &g_entries[i]);
+                        written++;
+                    }
+                }
+            }
+            if (fclose(f) != 0 || rename(tmp, g_path) != 0)
+                perror(g_path);
+        }
+    }
+    for (int i = 0; i < g_nentries; i++)
+        free(g_entries[i].output);
+    free(g_entries);
+    g_entries = NULL;
+    g_nentries = 0;
+    for (int i = 0; i < g_nmembers; i++) {
+        for (int d = 0; d < g_members[i].ndefines; d++)
+            free(g_members[i].defines[d]);
+        for (int n = 0; n < g_members[i].nneeds; n++)
+            free(g_members[i].needs[n]);
+        free(g_members[i].defines);
+        free(g_members[i].needs);
+    }
+    free(g_members);
+    g_members = NULL;
+    g_nmembers = 0;
+}
@@ -0,0 +1,74 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "tester.h"
+
+/*
+ * A file descriptor for the ft_put*_fd tests to write to, instead of the
+ * runner's stdout. Everything written is read back for an exact byte
+ * comparison. A memfd never blocks the writer, unlike a pipe nobody
+ * drains, so multi-megabyte writes are fine. The number of write(2)-family
+ * syscalls in between comes from the syscw line of /proc/self/io, which
+ * counts the calls the kernel actually saw, whether libft is linked or
+ * loaded with --lib.
+ */
+
+/* write(2)-family syscalls made by this process so far, -1 if unknown */
+static long syscalls_written(void) {
+    FILE *f = fopen("/proc/self/io", "r");
+    char line[128];
+    long n = -1;
+
+    if (!f)
+        return -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "syscw: %ld", &n) == 1)
+            break;
+    }
+    fclose(f);
+    return n;
+}
+
+/* Open an empty capture; c->fd is what the function under test gets */
+int capture_begin(t_capture *c) {
+    memset(c, 0, sizeof(*c));
+    c->fd = memfd_create("libft_test-capture", MFD_CLOEXEC);
+    if (c->fd < 0) {
+        FILE *tmp = tmpfile();
+        c->fd = tmp ? dup(fileno(tmp)) : -1;
+        if (tmp)
+            fclose(tmp);
+    }
+    if (c->fd < 0)
+        return 0;
+    c->writes = syscalls_written();
+    return 1;
+}
+
+/* Stop counting and read back what was written; data is NUL-terminated.
+ * It is mapped rather than malloc'ed so the test's heap stats stay its own */
+int capture_end(t_capture *c) {
+    long after = syscalls_written();
+    c->writes = c->writes < 0 || after < 0 ? -1 : after - c->writes;
+
+    off_t size = lseek(c->fd, 0, SEEK_END);
+    if (size < 0)
+        return 0;
+    void *p = mmap(NULL, (size_t)size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        return 0;
+    c->data = p;
+    c->len = (size_t)size;
+    return size == 0 || pread(c->fd, c->data, (size_t)size, 0) == size;
+}
+
+void capture_free(t_capture *c) {
+    if (c->fd >= 0)
+        close(c->fd);
+    if (c->data)
+        munmap(c->data, c->len + 1);
+    c->fd = -1;
+    c->data = NULL;
+}
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "tester.h"
+
+/* Sweep parameters */
+#define CPLX_MIN_SIZE     1024
+#define CPLX_REPS         3
+#define CPLX_STOP_NS      250000000LL  /* stop growing once one call takes this long */
+#define CPLX_FLOOR_NS     50000LL      /* points faster than this are too noisy to fit */
+#define CPLX_CHILD_LIMIT  60           /* seconds before a whole function is killed */
+#define CPLX_MAX_POINTS   32
+
+/* One function: build an input of size n, then call it on that input */
+typedef struct {
+    const char *name;
+    void *(*setup)(size_t n);
+    void (*run)(void *input, size_t n);
+    void (*teardown)(void *input);
+} t_cplx;
+
+/* Input shared by the string functions: up to two strings */
+typedef struct {
+    char *a;
+    char *b;
+    size_t cap;
+} t_cplx_input;
+
+static t_cplx_input *new_input(size_t a_len, size_t b_len) {
+    t_cplx_input *in = calloc(1, sizeof(*in));
+    if (!in)
+        return NULL;
+    in->a = malloc(a_len + 1);
+    in->b = malloc(b_len + 1);
+    if (!in->a || !in->b) {
+        free(in->a);
+        free(in->b);
+        free(in);
+        return NULL;
+    }
+    in->a[a_len] = '\0';
+    in->b[b_len] = '\0';
+    return in;
+}
+
+static void free_input(void *p) {
+    t_cplx_input *in = p;
+    free(in->a);
+    free(in->b);
+    free(in);
+}
+
+/* ft_strnstr: a haystack with no match, searched over its whole length */
+static void *setup_strnstr(size_t n) {
+    t_cplx_input *in = new_input(n, 2);
+    if (in) {
+        memset(in->a, 'a', n);
+        memcpy(in->b, "ab", 2);
+    }
+    return in;
+}
+
+static void run_strnstr(void *p, size_t n) {
+    t_cplx_input *in = p;
+    if (ft_strnstr(in->a, in->b, n) != NULL)
+        abort();
+}
+
+/* ft_strlcat: n/2 bytes appended to n/2 bytes */
+static void *setup_strlcat(size_t n) {
+    t_cplx_input *in = new_input(n, n / 2);
+    if (in) {
+        memset(in->b, 'b', n / 2);
+        in->cap = n + 1;
+    }
+    return in;
+}
+
+static void run_strlcat(void *p, size_t n) {
+    t_cplx_input *in = p;
+    memset(in->a, 'a', n / 2);
+    in->a[n / 2] = '\0';
+    ft_strlcat(in->a, in->b, in->cap);
+}
+
+/* ft_strtrim: n/2 kept bytes between n/4 trimmed bytes on each side */
+static void *setup_strtrim(size_t n) {
+    t_cplx_input *in = new_input(n, 2);
+    if (in) {
+        memset(in->a, ' ', n);
+        memset(in->a + n / 4, 'x', n / 2);
+        memcpy(in->b, " \t", 2);
+    }
+    return in;
+}
+
+static void run_strtrim(void *p, size_t n) {
+    t_cplx_input *in = p;
+    (void)n;
+    free(ft_strtrim(in->a, in->b));
+}
+
+/* ft_split: n bytes of two-letter words */
+static void *setup_split(size_t n) {
+    t_cplx_input *in = new_input(n, 0);
+    if (in) {
+        for (size_t i = 0; i < n; i++)
+            in->a[i] = (i % 3 == 2) ? ' ' : 'w';
+    }
+    return in;
+}
+
+static void run_split(void *p, size_t n) {
+    t_cplx_input *in = p;
+    char **words = ft_split(in->a, ' ');
+    (void)n;
+    if (!words)
+        return;
+    for (size_t i = 0; words[i]; i++)
+        free(words[i]);
+    free(words);
+}
+
+/* ft_substr: the whole string */
+static void *setup_substr(size_t n) {
+    t_cplx_input *in = new_input(n, 0);
+    if (in)
+        memset(in->a, 's', n);
+    return in;
+}
+
+static void run_substr(void *p, size_t n) {
+    t_cplx_input *in = p;
+    free(ft_substr(in->a, 0, n));
+}
+
+/* ft_strjoin: two halves of n bytes */
+static void *setup_strjoin(size_t n) {
+    t_cplx_input *in = new_input(n / 2, n - n / 2);
+    if (in) {
+        memset(in->a, 'a', n / 2);
+        memset(in->b, 'b', n - n / 2);
+    }
+    return in;
+}
+
+static void run_strjoin(void *p, size_t n) {
+    t_cplx_input *in = p;
+    (void)n;
+    free(ft_strjoin(in->a, in->b));
+}
+
+static const t_cplx g_cplx[] = {
+    { "ft_strnstr", setup_strnstr, run_strnstr, free_input },
+    { "ft_strlcat", setup_strlcat, run_strlcat, free_input },
+    { "ft_strtrim", setup_strtrim, run_strtrim, free_input },
+    { "ft_split",   setup_split,   run_split,   free_input },
+    { "ft_substr",  setup_substr,  run_substr,  free_input },
+    { "ft_strjoin", setup_strjoin, run_strjoin, free_input },
+};
+#define NCPLX (int)(sizeof(g_cplx) / sizeof(g_cplx[0]))
+
+/* Least-squares slope of log(time) against log(n): the growth exponent */
+double fit_exponent(const double *sizes, const double *times, int n) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int i = 0; i < n; i++) {
+        double x = log(sizes[i]);
+        double y = log(times[i]);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double den = n * sxx - sx * sx;
+    return den != 0 ? (n * sxy - sx * sy) / den : 0;
+}
+
+/* Time one function over growing sizes and print its row; runs in a child */
+static int check_function(const t_cplx *c, size_t max_size) {
+    double sizes[CPLX_MAX_POINTS];
+    double times[CPLX_MAX_POINTS];
+    int npoints = 0;
+    size_t n;
+
+    for (n = CPLX_MIN_SIZE; n <= max_size && npoints < CPLX_MAX_POINTS; n *= 2) {
+        void *input = c->setup(n);
+        if (!input)
+            break;
+        long long best = 0;
+        for (int r = 0; r < CPLX_REPS; r++) {
+            long long start = bench_now_ns();
+            c->run(input, n);
+            long long elapsed = bench_now_ns() - start;
+            if (r == 0 || elapsed < best)
+                best = elapsed;
+            if (elapsed > CPLX_STOP_NS)
+                break;
+        }
+        c->teardown(input);
+        sizes[npoints] = (double)n;
+        times[npoints] = (double)(best > 0 ? best : 1);
+        npoints++;
+        if (best > CPLX_STOP_NS)
+            break;
+    }
+    if (npoints == 0) {
+        if (max_size < CPLX_MIN_SIZE)
+            printf(YELLOW "  %-10s not measured: --bench-max is below %d bytes" RESET "\n",
+                   c->name, CPLX_MIN_SIZE);
+        else
+            printf(YELLOW "  %-10s could not allocate an input of %d bytes" RESET "\n",
+                   c->name, CPLX_MIN_SIZE);
+        return 0;
+    }
+
+    /* Fit only the points slow enough to be above timer noise */
+    int first = 0;
+    while (first < npoints - 3 && times[first] < CPLX_FLOOR_NS)
+        first++;
+    double k = npoints - first >= 2 ? fit_exponent(sizes + first, times + first, npoints - first) : 0;
+
+    char largest[16];
+    format_size((size_t)sizes[npoints - 1], largest, sizeof(largest));
+    const char *verdict = GREEN "linear" RESET;
+    if (k >= CPLX_QUADRATIC)
+        verdict = RED "QUADRATIC (expected linear)" RESET;
+    else if (k > CPLX_LINEAR)
+        verdict = YELLOW "superlinear" RESET;
+    printf("  %-10s %8s %12.3f %10.2f   %s\n", c->name, largest,
+           times[npoints - 1] / 1e6, k, verdict);
+    fflush(stdout);
+    return k >= CPLX_QUADRATIC ? 1 : 0;
+}
+
+/* Flag functions whose running time grows faster than their input */
+int run_complexity(const t_bench_config *cfg) {
+    int flagged = 0;
+
+    printf(BOLD CYAN "\n=== Complexity check (time ~ n^k) ===" RESET "\n");
+    printf(BOLD "  %-10s %8s %12s %10s   %s" RESET "\n",
+           "function", "max n", "time (ms)", "k", "verdict");
+    for (int i = 0; i < NCPLX; i++) {
+        if (cfg->only && strcmp(cfg->only, g_cplx[i].name) != 0)
+            continue;
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            alarm(CPLX_CHILD_LIMIT);
+            exit(check_function(&g_cplx[i], cfg->max_size));
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+            perror("libft_test: complexity");
+            flagged++;
+        } else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+            printf(RED "  %-10s TIMEOUT after %d s (far worse than linear)" RESET "\n",
+                   g_cplx[i].name, CPLX_CHILD_LIMIT);
+            flagged++;
+        } else if (WIFSIGNALED(status)) {
+            printf(RED "  %-10s crashed: %s" RESET "\n",
+                   g_cplx[i].name, strsignal(WTERMSIG(status)));
+            flagged++;
+        } else if (WEXITSTATUS(status) != 0) {
+            flagged++;
+        }
+    }
+    return flagged ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "tester.h"
+
+/* Most allocations a single case may make before injection gives up */
+#define FI_MAX_ALLOCS  256
+
+/* One allocating call; `release` frees whatever `call` returned */
+typedef struct {
+    const char *name;
+    void *(*call)(void);
+    void (*release)(void *result);
+} t_fi_case;
+
+/* One child run: `fail_at` = 0 only counts the allocations */
+typedef struct {
+    int c;
+    long fail_at;
+    t_alloc_stats alloc;
+    int returned;
+    int done;
+    int status;
+} t_fi_job;
+
+static void release_free(void *p) {
+    free(p);
+}
+
+static void release_split(void *p) {
+    char **words = p;
+    for (size_t i = 0; words[i]; i++)
+        free(words[i]);
+    free(words);
+}
+
+static char fi_upper(unsigned int i, char c) {
+    (void)i;
+    return (char)ft_toupper(c);
+}
+
+static void *fi_split(void) { return ft_split("  split  these few  words ", ' '); }
+static void *fi_strjoin(void) { return ft_strjoin("Hello, ", "World!"); }
+static void *fi_substr(void) { return ft_substr("Hello, World!", 7, 5); }
+static void *fi_strtrim(void) { return ft_strtrim("  \t trim me \t  ", " \t"); }
+static void *fi_itoa(void) { return ft_itoa(-2147483647 - 1); }
+static void *fi_strdup(void) { return ft_strdup("duplicate me"); }
+static void *fi_calloc(void) { return ft_calloc(16, sizeof(int)); }
+static void *fi_strmapi(void) { return ft_strmapi("map me", fi_upper); }
+
+#ifdef BONUS
+/* ft_lstmap copies each content with malloc; when a node cannot be made,
+ * the copy it was meant for has to be deleted too */
+static t_list g_fi_nodes[3] = {
+    { "one", &g_fi_nodes[1] }, { "two", &g_fi_nodes[2] }, { "three", NULL }
+};
+static int g_fi_copy_failed = 0;
+
+static void *fi_copy(void *content) {
+    char *copy = ft_strdup(content);
+    if (!copy)
+        g_fi_copy_failed = 1;
+    return copy;
+}
+
+static void *fi_lstmap(void) {
+    t_list *r = ft_lstmap(g_fi_nodes, fi_copy, free);
+    /* A NULL content is the callback's failure, which ft_lstmap may keep */
+    if (r && g_fi_copy_failed)
+        ft_lstclear(&r, free);
+    return r;
+}
+
+static void release_list(void *p) {
+    t_list *l = p;
+    ft_lstclear(&l, free);
+}
+#endif
+
+static const t_fi_case g_fi_cases[] = {
+    { "ft_split",   fi_split,   release_split },
+    { "ft_strjoin", fi_strjoin, release_free },
+    { "ft_substr",  fi_substr,  release_free },
+    { "ft_strtrim", fi_strtrim, release_free },
+    { "ft_itoa",    fi_itoa,    release_free },
+    { "ft_strdup",  fi_strdup,  release_free },
+    { "ft_calloc",  fi_calloc,  release_free },
+    { "ft_strmapi", fi_strmapi, release_free },
+#ifdef BONUS
+    { "ft_lstmap",  fi_lstmap,  release_list },
+#endif
+};
+#define NFI_CASES (int)(sizeof(g_fi_cases) / sizeof(g_fi_cases[0]))
+
+/* Child side: make the call under injection and record what happened */
+static void fi_child(t_fi_job *job) {
+    const t_fi_case *fc = &g_fi_cases[job->c];
+
+    alloc_fail_at(job->fail_at);
+    alloc_begin();
+    void *r = fc->call();
+    alloc_end(&job->alloc);
+    job->returned = r != NULL;
+    if (r)
+        fc->release(r);
+    job->done = 1;
+    _exit(0);
+}
+
+/* Run every job in its own child, up to `parallel` at once */
+static void run_batch(t_fi_job *jobs, int n, int parallel, long timeout_ms) {
+    pid_t pids[parallel];
+    int ids[parallel];
+    int active = 0;
+    int next = 0;
+
+    while (next < n || active > 0) {
+        while (active < parallel && next < n) {
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid == 0) {
+                if (timeout_ms > 0)
+                    alarm((unsigned)((timeout_ms + 999) / 1000));
+                fi_child(&jobs[next]);
+            }
+            if (pid < 0) {
+                if (active > 0)
+                    break;
+                perror("libft_test: fork");
+                exit(2);
+            }
+            pids[active] = pid;
+            ids[active] = next++;
+            active++;
+        }
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            perror("libft_test: waitpid");
+            exit(2);
+        }
+        for (int i = 0; i < active; i++) {
+            if (pids[i] != pid)
+                continue;
+            jobs[ids[i]].status = status;
+            active--;
+            pids[i] = pids[active];
+            ids[i] = ids[active];
+            break;
+        }
+    }
+}
+
+/* Describe a failed injection run in `buf`; returns 0 if it behaved */
+static int fi_verdict(const t_fi_job *job, char *buf, size_t len) {
+    if (WIFSIGNALED(job->status)) {
+        int sig = WTERMSIG(job->status);
+        snprintf(buf, len, "%s", sig == SIGALRM ? "TIMEOUT" :
+                 (sig == SIGSEGV ? "SEGFAULT" : strsignal(sig)));
+        return 1;
+    }
+    if (!job->done) {
+        snprintf(buf, len, "exited with status %d", WEXITSTATUS(job->status));
+        return 1;
+    }
+    if (!job->fail_at || job->alloc.failed == 0)
+        return 0;
+    if (job->returned) {
+        snprintf(buf, len, "returned non-NULL");
+        return 1;
+    }
+    if (job->alloc.leaked_blocks > 0) {
+        char size[16];
+        format_size(job->alloc.leaked_bytes, size, sizeof(size));
+        snprintf(buf, len, "leaked %s in %ld block%s", size, job->alloc.leaked_blocks,
+                 job->alloc.leaked_blocks == 1 ? "" : "s");
+        return 1;
+    }
+    return 0;
+}
+
+/* Fail each allocation of every case in turn: the call must return
+ * NULL, free what it already allocated, and not crash */
+int run_failinject(const t_run_config *cfg, const char *only) {
+    int parallel = cfg->jobs < 1 ? 1 : cfg->jobs;
+    int flagged = 0;
+    size_t map_size = (size_t)NFI_CASES * FI_MAX_ALLOCS * sizeof(t_fi_job);
+    t_fi_job *jobs = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    t_fi_job counts[NFI_CASES];
+    int ncases = 0;
+
+    if (jobs == MAP_FAILED) {
+        perror("libft_test: mmap");
+        return 2;
+    }
+    printf(BOLD CYAN "\n=== Malloc failure injection ===" RESET "\n");
+
+    /* Count each case's allocations with nothing failing */
+    t_fi_job *count_jobs = jobs;
+    for (int c = 0; c < NFI_CASES; c++) {
+        if (only && strcmp(only, g_fi_cases[c].name) != 0)
+            continue;
+        memset(&count_jobs[ncases], 0, sizeof(t_fi_job));
+        count_jobs[ncases++].c = c;
+    }
+    run_batch(count_jobs, ncases, parallel, cfg->timeout_ms);
+    memcpy(counts, count_jobs, ncases * sizeof(t_fi_job));
+
+    /* Then fail allocation 1, 2, ..., N of every case, all in parallel */
+    int njobs = 0;
+    for (int i = 0; i < ncases; i++) {
+        char why[64];
+        if (fi_verdict(&counts[i], why, sizeof(why)))
+            continue;
+        long n = counts[i].alloc.allocs < FI_MAX_ALLOCS ? counts[i].alloc.allocs : FI_MAX_ALLOCS;
+        for (long k = 1; k <= n; k++) {
+            memset(&jobs[njobs], 0, sizeof(t_fi_job));
+            jobs[njobs].c = counts[i].c;
+            jobs[njobs++].fail_at = k;
+        }
+    }
+    run_batch(jobs, njobs, parallel, cfg->timeout_ms);
+
+    int j = 0;
+    for (int i = 0; i < ncases; i++) {
+        const t_fi_case *fc = &g_fi_cases[counts[i].c];
+        char why[64];
+        if (fi_verdict(&counts[i], why, sizeof(why))) {
+            printf(RED "  %-10s ✗ fails without injection: %s" RESET "\n", fc->name, why);
+            flagged++;
+            continue;
+        }
+        long n = counts[i].alloc.allocs;
+        int bad = 0;
+        printf("  %-10s %3ld alloc%s ", fc->name, n, n == 1 ? " " : "s");
+        for (; j < njobs && jobs[j].c == counts[i].c; j++) {
+            if (!fi_verdict(&jobs[j], why, sizeof(why)))
+                continue;
+            printf("%s\n" RED "    ✗ allocation #%ld failed: %s" RESET, bad ? "" : RED "✗" RESET,
+                   jobs[j].fail_at, why);
+            bad++;
+        }
+        if (n == 0)
+            printf(YELLOW "- never allocates" RESET "\n");
+        else if (bad)
+            printf("\n");
+        else
+            printf(GREEN "✓ NULL returned, nothing leaked, at every failure point" RESET "\n");
+        flagged += bad;
+    }
+    fflush(stdout);
+    munmap(jobs, map_size);
+    return flagged ? 1 : 0;
+}
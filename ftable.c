@@ -0,0 +1,311 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <link.h>
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#define FTABLE_NO_REDIRECT
+#include "ftable.h"
+
+/*
+ * Resolve the libft functions of a shared object with dlopen/dlsym and
+ * route its allocations and writes through alloc.c and io.c, so that a dlopen'ed libft is
+ * tested exactly like a linked libft.a. run_libs() runs the registered
+ * tests against several such libraries, one child process each.
+ */
+
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+void  __wrap_free(void *ptr);
+ssize_t __wrap_write(int fd, const void *buf, size_t n);
+
+/* The functions of the linked libft.a, until load_libft() replaces them */
+t_libft g_ft = {
+#define FT_LINKED(f) ft_##f,
+    LIBFT_FUNCTIONS(FT_LINKED)
+#undef FT_LINKED
+};
+
+/* Stands in for a function the library does not define */
+static void missing_function(void) {
+    fprintf(stderr, "libft_test: called a function missing from the library\n");
+    abort();
+}
+
+#if defined(__x86_64__)
+# define IS_SLOT(type) ((type) == R_X86_64_JUMP_SLOT || (type) == R_X86_64_GLOB_DAT)
+#elif defined(__aarch64__)
+# define IS_SLOT(type) ((type) == R_AARCH64_JUMP_SLOT || (type) == R_AARCH64_GLOB_DAT)
+#endif
+
+#ifdef IS_SLOT
+/* glibc relocates most of a loaded object's dynamic entries in place */
+static uintptr_t dyn_addr(ElfW(Addr) base, ElfW(Addr) p) {
+    return p < base ? base + p : p;
+}
+
+/* Rewrite the relocated slots for the allocator and write() in `n` entries */
+static int patch_slots(ElfW(Addr) base, const ElfW(Rela) *rel, size_t n,
+                       const ElfW(Sym) *symtab, const char *strtab) {
+    static const struct {
+        const char *name;
+        void *wrapper;
+    } hooks[] = {
+        { "malloc",  (void *)__wrap_malloc },
+        { "calloc",  (void *)__wrap_calloc },
+        { "realloc", (void *)__wrap_realloc },
+        { "free",    (void *)__wrap_free },
+        { "write",   (void *)__wrap_write },
+    };
+    long page = sysconf(_SC_PAGESIZE);
+    int patched = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (!IS_SLOT(ELF64_R_TYPE(rel[i].r_info)))
+            continue;
+        const char *name = strtab + symtab[ELF64_R_SYM(rel[i].r_info)].st_name;
+        for (size_t h = 0; h < sizeof(hooks) / sizeof(hooks[0]); h++) {
+            if (strcmp(name, hooks[h].name) != 0)
+                continue;
+            void **slot = (void **)(base + rel[i].r_offset);
+            /* RELRO may have made the GOT read-only */
+            uintptr_t start = (uintptr_t)slot & ~(uintptr_t)(page - 1);
+            if (mprotect((void *)start, page, PROT_READ | PROT_WRITE) != 0)
+                continue;
+            *slot = hooks[h].wrapper;
+            patched++;
+        }
+    }
+    return patched;
+}
+#endif
+
+/* Point the library's malloc/calloc/realloc/free at alloc.c's wrappers and
+ * its write at io.c's. --wrap only applies to what is linked statically,
+ * so without this a dlopen'ed libft's allocations would go untracked. */
+static int hook_allocator(void *handle) {
+#ifdef IS_SLOT
+    struct link_map *lm;
+    const ElfW(Sym) *symtab = NULL;
+    const char *strtab = NULL;
+    const ElfW(Rela) *jmprel = NULL;
+    const ElfW(Rela) *rela = NULL;
+    size_t jmprelsz = 0;
+    size_t relasz = 0;
+
+    if (dlinfo(handle, RTLD_DI_LINKMAP, &lm) != 0)
+        return 0;
+    for (const ElfW(Dyn) *d = lm->l_ld; d->d_tag != DT_NULL; d++) {
+        if (d->d_tag == DT_SYMTAB)
+            symtab = (const void *)dyn_addr(lm->l_addr, d->d_un.d_ptr);
+        else if (d->d_tag == DT_STRTAB)
+            strtab = (const void *)dyn_addr(lm->l_addr, d->d_un.d_ptr);
+        else if (d->d_tag == DT_JMPREL)
+            jmprel = (const void *)dyn_addr(lm->l_addr, d->d_un.d_ptr);
+        else if (d->d_tag == DT_PLTRELSZ)
+            jmprelsz = d->d_un.d_val;
+        else if (d->d_tag == DT_RELA)
+            rela = (const void *)dyn_addr(lm->l_addr, d->d_un.d_ptr);
+        else if (d->d_tag == DT_RELASZ)
+            relasz = d->d_un.d_val;
+    }
+    if (!symtab || !strtab)
+        return 0;
+    int patched = 0;
+    if (jmprel)
+        patched += patch_slots(lm->l_addr, jmprel, jmprelsz / sizeof(*jmprel), symtab, strtab);
+    if (rela)
+        patched += patch_slots(lm->l_addr, rela, relasz / sizeof(*rela), symtab, strtab);
+    return patched;
+#else
+    (void)handle;
+    return -1;
+#endif
+}
+
+/* Make g_ft point at the functions of the shared object `path`. Missing
+ * functions abort when called. Returns 0 if the library cannot be loaded */
+int load_libft(const char *path) {
+    char local[4096];
+
+    /* dlopen only searches the library path for bare names */
+    if (!strchr(path, '/')) {
+        snprintf(local, sizeof(local), "./%s", path);
+        path = local;
+    }
+    void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        fprintf(stderr, "libft_test: %s\n", dlerror());
+        return 0;
+    }
+#define FT_RESOLVE(f) \
+    if ((g_ft.f = dlsym(handle, "ft_" #f)) == NULL) { \
+        g_ft.f = (__typeof__(g_ft.f))missing_function; \
+        fprintf(stderr, "libft_test: %s: no ft_" #f "\n", path); \
+    }
+    LIBFT_FUNCTIONS(FT_RESOLVE)
+#undef FT_RESOLVE
+    if (hook_allocator(handle) < 0)
+        fprintf(stderr, "libft_test: %s: heap use not tracked on this platform\n", path);
+    return 1;
+}
+
+/* Outcome of the whole suite against one library */
+typedef struct {
+    const char *path;
+    pid_t pid;
+    FILE *results;
+    int loaded;
+    t_stats stats;
+    char failing[512];
+} t_lib_run;
+
+/* Note `function` among the failing ones, once */
+static void add_failing(t_lib_run *r, const char *function) {
+    size_t len = strlen(r->failing);
+    size_t flen = strlen(function);
+
+    for (const char *p = r->failing; (p = strstr(p, function)) != NULL; p += flen) {
+        if ((p == r->failing || p[-1] == ' ') && (p[flen] == ' ' || p[flen] == '\0'))
+            return;
+    }
+    if (len + flen + 5 >= sizeof(r->failing)) {
+        if (!strstr(r->failing, "..."))
+            strcat(r->failing, " ...");
+        return;
+    }
+    if (len > 0)
+        r->failing[len++] = ' ';
+    memcpy(r->failing + len, function, flen + 1);
+}
+
+/* Load one library and run the registered tests against it, writing
+ * JSON lines to `out`. Never returns */
+static void run_lib_child(const char *path, FILE *out, const t_run_config *cfg) {
+    t_run_config child = *cfg;
+
+    if (!load_libft(path))
+        _exit(3);
+    fflush(stdout);
+    if (dup2(fileno(out), STDOUT_FILENO) < 0)
+        _exit(2);
+    child.jobs = 1;
+    child.format = FORMAT_JSON;
+    child.output_path = NULL;
+    run_tests(&child);
+    _exit(0);
+}
+
+/* Read a finished child's JSON lines into its row of the matrix */
+static void collect_lib(t_lib_run *r, int status) {
+    char *line = NULL;
+    size_t cap = 0;
+    t_json_record rec;
+
+    r->loaded = !(WIFEXITED(status) && WEXITSTATUS(status) == 3);
+    rewind(r->results);
+    while (getline(&line, &cap, r->results) > 0) {
+        if (!read_json_record(line, &rec))
+            continue;
+        r->stats.total++;
+        r->stats.passed += rec.outcome == OUTCOME_PASS;
+        r->stats.failed += rec.outcome != OUTCOME_PASS;
+        r->stats.segfaults += rec.outcome == OUTCOME_SEGFAULT;
+        r->stats.timeouts += rec.outcome == OUTCOME_TIMEOUT;
+        if (rec.outcome != OUTCOME_PASS)
+            add_failing(r, rec.function);
+    }
+    free(line);
+    fclose(r->results);
+    r->results = NULL;
+    /* A child that died outside a test lost the rest of the suite */
+    if (r->loaded && !(WIFEXITED(status) && WEXITSTATUS(status) == 0))
+        add_failing(r, "(runner crashed)");
+}
+
+static void print_matrix(const t_lib_run *runs, int n) {
+    int width = 7;
+
+    for (int i = 0; i < n; i++) {
+        int len = (int)strlen(runs[i].path);
+        if (len > width)
+            width = len > 48 ? 48 : len;
+    }
+    printf(BOLD CYAN "\n=== LIBRARY MATRIX ===" RESET "\n");
+    printf("%-*s %6s %6s %6s %6s  %s\n", width, "library", "pass", "fail", "segv", "tmout",
+           "failing functions");
+    for (int i = 0; i < n; i++) {
+        const t_lib_run *r = &runs[i];
+        if (!r->loaded) {
+            printf("%-*s " RED "%s" RESET "\n", width, r->path, "cannot be loaded");
+            continue;
+        }
+        printf("%-*s " GREEN "%6d" RESET " %s%6d" RESET " %s%6d" RESET " %s%6d" RESET "  %s\n",
+               width, r->path, r->stats.passed,
+               r->stats.failed ? RED : "", r->stats.failed,
+               r->stats.segfaults ? MAGENTA : "", r->stats.segfaults,
+               r->stats.timeouts ? MAGENTA : "", r->stats.timeouts, r->failing);
+    }
+}
+
+/* Run the registered tests against each of the `n` libraries, up to
+ * cfg->jobs libraries at a time, and print one row per library. Returns
+ * 0 only if every library loads and passes every test */
+int run_libs(const char **paths, int n, const t_run_config *cfg) {
+    t_lib_run *runs = calloc(n, sizeof(*runs));
+    int jobs = cfg->jobs < 1 ? 1 : cfg->jobs;
+    int active = 0;
+    int next = 0;
+    int ok = 1;
+
+    if (!runs) {
+        perror("libft_test");
+        return 2;
+    }
+    fflush(stdout);
+    while (next < n || active > 0) {
+        while (active < jobs && next < n) {
+            t_lib_run *r = &runs[next];
+            r->path = paths[next++];
+            r->results = tmpfile();
+            if (!r->results) {
+                perror("libft_test: tmpfile");
+                exit(2);
+            }
+            r->pid = fork();
+            if (r->pid < 0) {
+                perror("libft_test: fork");
+                exit(2);
+            }
+            if (r->pid == 0)
+                run_lib_child(r->path, r->results, cfg);
+            active++;
+        }
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            perror("libft_test: waitpid");
+            exit(2);
+        }
+        for (int i = 0; i < next; i++) {
+            if (runs[i].pid == pid && runs[i].results) {
+                collect_lib(&runs[i], status);
+                active--;
+                break;
+            }
+        }
+    }
+    print_matrix(runs, n);
+    for (int i = 0; i < n; i++) {
+        if (!runs[i].loaded || runs[i].stats.passed != runs[i].stats.total || runs[i].failing[0])
+            ok = 0;
+    }
+    free(runs);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+#ifndef FTABLE_H
+#define FTABLE_H
+
+#include "tester.h"
+
+/*
+ * The libft functions the tests call, as a table of pointers. g_ft points
+ * at the linked libft.a by default; --lib swaps in the functions of a
+ * shared object (see ftable.c). Files that include this header call
+ * ft_* through the table; the rest of the tester calls libft.a directly.
+ */
+
+#define LIBFT_FUNCTIONS(X) \
+    X(isalpha) X(isdigit) X(isalnum) X(isascii) X(isprint) X(toupper) X(tolower) \
+    X(strlen) X(memset) X(bzero) X(memcpy) X(memmove) X(memchr) X(memcmp) \
+    X(strlcpy) X(strlcat) X(strchr) X(strrchr) X(strncmp) X(strnstr) X(atoi) \
+    X(calloc) X(strdup) X(substr) X(strjoin) X(strtrim) X(split) X(itoa) \
+    X(strmapi) X(striteri) X(putchar_fd) X(putstr_fd) X(putendl_fd) X(putnbr_fd) \
+    LIBFT_BONUS_FUNCTIONS(X)
+
+/* The t_list functions, only in a BONUS=1 build */
+#ifdef BONUS
+# define LIBFT_BONUS_FUNCTIONS(X) \
+    X(lstnew) X(lstadd_front) X(lstadd_back) X(lstsize) X(lstlast) \
+    X(lstdelone) X(lstclear) X(lstiter) X(lstmap)
+#else
+# define LIBFT_BONUS_FUNCTIONS(X)
+#endif
+
+typedef struct {
+#define FT_MEMBER(f) __typeof__(ft_##f) *f;
+    LIBFT_FUNCTIONS(FT_MEMBER)
+#undef FT_MEMBER
+} t_libft;
+
+extern t_libft g_ft;
+
+int  load_libft(const char *path);
+int  run_libs(const char **paths, int n, const t_run_config *cfg);
+
+#ifndef FTABLE_NO_REDIRECT
+# define ft_isalpha     (g_ft.isalpha)
+# define ft_isdigit     (g_ft.isdigit)
+# define ft_isalnum     (g_ft.isalnum)
+# define ft_isascii     (g_ft.isascii)
+# define ft_isprint     (g_ft.isprint)
+# define ft_toupper     (g_ft.toupper)
+# define ft_tolower     (g_ft.tolower)
+# define ft_strlen      (g_ft.strlen)
+# define ft_memset      (g_ft.memset)
+# define ft_bzero       (g_ft.bzero)
+# define ft_memcpy      (g_ft.memcpy)
+# define ft_memmove     (g_ft.memmove)
+# define ft_memchr      (g_ft.memchr)
+# define ft_memcmp      (g_ft.memcmp)
+# define ft_strlcpy     (g_ft.strlcpy)
+# define ft_strlcat     (g_ft.strlcat)
+# define ft_strchr      (g_ft.strchr)
+# define ft_strrchr     (g_ft.strrchr)
+# define ft_strncmp     (g_ft.strncmp)
+# define ft_strnstr     (g_ft.strnstr)
+# define ft_atoi        (g_ft.atoi)
+# define ft_calloc      (g_ft.calloc)
+# define ft_strdup      (g_ft.strdup)
+# define ft_substr      (g_ft.substr)
+# define ft_strjoin     (g_ft.strjoin)
+# define ft_strtrim     (g_ft.strtrim)
+# define ft_split       (g_ft.split)
+# define ft_itoa        (g_ft.itoa)
+# define ft_strmapi     (g_ft.strmapi)
+# define ft_striteri    (g_ft.striteri)
+# define ft_putchar_fd  (g_ft.putchar_fd)
+# define ft_putstr_fd   (g_ft.putstr_fd)
+# define ft_putendl_fd  (g_ft.putendl_fd)
+# define ft_putnbr_fd   (g_ft.putnbr_fd)
+# ifdef BONUS
+#  define ft_lstnew       (g_ft.lstnew)
+#  define ft_lstadd_front (g_ft.lstadd_front)
+#  define ft_lstadd_back  (g_ft.lstadd_back)
+#  define ft_lstsize      (g_ft.lstsize)
+#  define ft_lstlast      (g_ft.lstlast)
+#  define ft_lstdelone    (g_ft.lstdelone)
+#  define ft_lstclear     (g_ft.lstclear)
+#  define ft_lstiter      (g_ft.lstiter)
+#  define ft_lstmap       (g_ft.lstmap)
+# endif
+#endif
+
+#endif
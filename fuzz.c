@@ -0,0 +1,370 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <ctype.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include "tester.h"
+
+/* Engine parameters */
+#define FUZZ_MAX_WORKERS     256
+#define FUZZ_CALL_LIMIT_MS   1000          /* one call taking longer is a hang */
+#define FUZZ_SHRINK_NS       20000000000LL /* time spent minimizing a reproducer */
+
+#define NELEMS(a) (sizeof(a) / sizeof((a)[0]))
+
+/* State shared between the runner and the workers fuzzing one function */
+typedef struct {
+    int stop;
+    long failed_iter;
+    char why[256];
+    long current[FUZZ_MAX_WORKERS];
+    long done[FUZZ_MAX_WORKERS];
+} t_fuzz_shared;
+
+/* splitmix64: tiny, fast and good enough to drive input generation */
+static uint64_t next_rand(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Buffer lengths, biased towards word and vector boundaries */
+static size_t pick_len(uint64_t *r) {
+    static const size_t edges[] = { 0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33,
+                                    63, 64, 65, 255, 256 };
+    if (next_rand(r) % 2)
+        return edges[next_rand(r) % NELEMS(edges)];
+    return next_rand(r) % (FUZZ_MAX_LEN + 1);
+}
+
+/* Character arguments: sign, high-bit and out-of-range ints included */
+static int pick_char(uint64_t *r) {
+    static const int edges[] = { 0, 'a', 'z', ' ', '-', '+', '0', 127, 128, 200, 255,
+                                 256 + 'a', -1, -129, INT_MIN, INT_MAX };
+    uint64_t x = next_rand(r);
+    if (x % 2)
+        return edges[(x >> 8) % NELEMS(edges)];
+    return (int)((x >> 8) % 256);
+}
+
+/* Length and offset arguments, SIZE_MAX and int limits included */
+static size_t pick_n(uint64_t *r, const t_fuzz_input *in) {
+    const size_t edges[] = { 0, 1, 2, 4, 8, in->alen, in->alen + 1,
+                             in->alen ? in->alen - 1 : 0, in->blen, in->blen + 1,
+                             SIZE_MAX, SIZE_MAX / 2 + 1, INT_MAX, (size_t)INT_MAX + 1,
+                             UINT_MAX };
+    if (next_rand(r) % 4)
+        return edges[next_rand(r) % NELEMS(edges)];
+    return next_rand(r) % (2 * FUZZ_MAX_LEN);
+}
+
+/* Buffer contents: random, NUL-riddled, high-bit, dense in c, or number-like */
+static void fill_bytes(uint64_t *r, unsigned char *p, size_t n, int c) {
+    static const char numeric[] = " \t\n\v\f\r+-0123456789";
+    int style = (int)(next_rand(r) % 5);
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t x = next_rand(r);
+        if (style == 0)
+            p[i] = (unsigned char)x;
+        else if (style == 1)
+            p[i] = x % 16 == 0 ? '\0' : (unsigned char)('a' + x % 26);
+        else if (style == 2)
+            p[i] = (unsigned char)(0x80 | x);
+        else if (style == 3)
+            p[i] = x % 4 == 0 ? (unsigned char)c : (unsigned char)('a' + (x >> 8) % 3);
+        else
+            p[i] = (unsigned char)numeric[x % (sizeof(numeric) - 1)];
+    }
+}
+
+/* Input number `iter` for oracle `idx`; a pure function of its arguments */
+static void generate(unsigned long seed, int idx, long iter, t_fuzz_input *in) {
+    uint64_t r = (uint64_t)seed ^ ((uint64_t)idx << 48) ^ (uint64_t)iter * 0xD1B54A32D192ED03ULL;
+
+    in->c = pick_char(&r);
+    in->alen = pick_len(&r);
+    in->blen = next_rand(&r) % 2 ? next_rand(&r) % 4 : pick_len(&r);
+    fill_bytes(&r, in->a, in->alen, in->c);
+    fill_bytes(&r, in->b, in->blen, in->c);
+    in->n = pick_n(&r, in);
+    in->off = pick_n(&r, in);
+}
+
+/* One-shot timer that turns a hanging call into SIGALRM */
+static void arm_call_limit(long ms) {
+    struct itimerval it;
+    memset(&it, 0, sizeof(it));
+    it.it_value.tv_sec = ms / 1000;
+    it.it_value.tv_usec = (ms % 1000) * 1000;
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+static void describe_signal(const char *name, int sig, char *buf, size_t len) {
+    if (sig == SIGALRM)
+        snprintf(buf, len, "%s hung for more than %d ms", name, FUZZ_CALL_LIMIT_MS);
+    else if (sig == SIGSEGV)
+        snprintf(buf, len, "%s crashed: SEGFAULT", name);
+    else
+        snprintf(buf, len, "%s crashed: %s", name, strsignal(sig));
+}
+
+/* Worker `w` of `jobs`: iterations w, w + jobs, ... until the budget runs out */
+static void fuzz_worker(const t_oracle *o, int idx, int w, int jobs,
+                        const t_fuzz_config *cfg, long long deadline, t_fuzz_shared *sh) {
+    t_fuzz_input in;
+    char why[sizeof(sh->why)];
+
+    for (long iter = w; (cfg->iters <= 0 || iter < cfg->iters) && !sh->stop; iter += jobs) {
+        if (deadline && (iter / jobs) % 64 == 0 && bench_now_ns() >= deadline)
+            break;
+        generate(cfg->seed, idx, iter, &in);
+        sh->current[w] = iter;
+        arm_call_limit(FUZZ_CALL_LIMIT_MS);
+        int ok = o->check(&in, why, sizeof(why));
+        sh->done[w]++;
+        if (!ok) {
+            if (__sync_bool_compare_and_swap(&sh->stop, 0, 1)) {
+                sh->failed_iter = iter;
+                memcpy(sh->why, why, sizeof(why));
+            }
+            _exit(1);
+        }
+    }
+    _exit(0);
+}
+
+/* Run one check in a child, so that crashes and hangs count as failures */
+static int fails_in_child(const t_oracle *o, const t_fuzz_input *in, t_fuzz_shared *sh) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        arm_call_limit(FUZZ_CALL_LIMIT_MS);
+        _exit(o->check(in, sh->why, sizeof(sh->why)) ? 0 : 1);
+    }
+    int status = 0;
+    if (pid < 0 || waitpid(pid, &status, 0) < 0)
+        return 0;
+    if (WIFSIGNALED(status)) {
+        describe_signal(o->name, WTERMSIG(status), sh->why, sizeof(sh->why));
+        return 1;
+    }
+    return WEXITSTATUS(status) != 0;
+}
+
+static unsigned char *buffer_of(t_fuzz_input *in, int which, size_t **len) {
+    *len = which ? &in->blen : &in->alen;
+    return which ? in->b : in->a;
+}
+
+/* Delete ever smaller chunks of one buffer while the failure persists */
+static int shrink_buffer(const t_oracle *o, t_fuzz_input *in, int which,
+                         t_fuzz_shared *sh, long long stop_at) {
+    t_fuzz_input cand;
+    size_t *len;
+    int progress = 0;
+
+    buffer_of(in, which, &len);
+    for (size_t chunk = *len / 2 ? *len / 2 : 1; chunk >= 1; chunk /= 2) {
+        for (size_t i = 0; i + chunk <= *len && bench_now_ns() < stop_at; ) {
+            size_t *clen;
+            cand = *in;
+            unsigned char *p = buffer_of(&cand, which, &clen);
+            memmove(p + i, p + i + chunk, *clen - i - chunk);
+            *clen -= chunk;
+            if (fails_in_child(o, &cand, sh)) {
+                *in = cand;
+                progress = 1;
+            } else {
+                i += chunk;
+            }
+        }
+    }
+    return progress;
+}
+
+/* Replace bytes by plain 'a' where that keeps the failure */
+static int simplify_bytes(const t_oracle *o, t_fuzz_input *in, int which,
+                          t_fuzz_shared *sh, long long stop_at) {
+    size_t *len;
+    unsigned char *p = buffer_of(in, which, &len);
+    int progress = 0;
+
+    for (size_t i = 0; i < *len && bench_now_ns() < stop_at; i++) {
+        if (p[i] == 'a')
+            continue;
+        unsigned char saved = p[i];
+        p[i] = 'a';
+        if (fails_in_child(o, in, sh))
+            progress = 1;
+        else
+            p[i] = saved;
+    }
+    return progress;
+}
+
+/* Move a length/offset towards 0 while the failure persists */
+static int shrink_value(const t_oracle *o, t_fuzz_input *in, size_t *v, t_fuzz_shared *sh) {
+    size_t saved = *v;
+    const size_t cands[] = { 0, 1, saved / 2, saved - 1 };
+
+    for (size_t i = 0; i < NELEMS(cands); i++) {
+        if (cands[i] >= saved)
+            continue;
+        *v = cands[i];
+        if (fails_in_child(o, in, sh))
+            return 1;
+    }
+    *v = saved;
+    return 0;
+}
+
+static int simplify_char(const t_oracle *o, t_fuzz_input *in, t_fuzz_shared *sh) {
+    const int cands[] = { 0, 'a' };
+    int saved = in->c;
+
+    for (size_t i = 0; i < NELEMS(cands) && cands[i] != saved; i++) {
+        in->c = cands[i];
+        if (fails_in_child(o, in, sh))
+            return 1;
+    }
+    in->c = saved;
+    return 0;
+}
+
+/* Shrink a failing input until no single step keeps it failing */
+static void minimize(const t_oracle *o, t_fuzz_input *in, t_fuzz_shared *sh) {
+    long long stop_at = bench_now_ns() + FUZZ_SHRINK_NS;
+    int progress = 1;
+
+    while (progress && bench_now_ns() < stop_at) {
+        progress = 0;
+        progress |= shrink_buffer(o, in, 0, sh, stop_at);
+        progress |= shrink_buffer(o, in, 1, sh, stop_at);
+        progress |= shrink_value(o, in, &in->n, sh);
+        progress |= shrink_value(o, in, &in->off, sh);
+        progress |= simplify_char(o, in, sh);
+        progress |= simplify_bytes(o, in, 0, sh, stop_at);
+        progress |= simplify_bytes(o, in, 1, sh, stop_at);
+    }
+    fails_in_child(o, in, sh);
+}
+
+static void print_bytes(const char *label, const unsigned char *p, size_t n) {
+    printf("      %-4s = \"", label);
+    for (size_t i = 0; i < n; i++) {
+        if (isprint(p[i]) && p[i] != '"' && p[i] != '\\')
+            putchar(p[i]);
+        else
+            printf("\\x%02x", p[i]);
+    }
+    printf("\" (%zu byte%s)\n", n, n == 1 ? "" : "s");
+}
+
+static void print_size(const char *label, size_t v) {
+    if (v == SIZE_MAX)
+        printf("      %-4s = SIZE_MAX\n", label);
+    else
+        printf("      %-4s = %zu\n", label, v);
+}
+
+/* Fuzz one function with `jobs` workers; 1 if it diverged */
+static int fuzz_function(const t_oracle *o, int idx, int jobs, const t_fuzz_config *cfg,
+                         long long budget_ns, t_fuzz_shared *sh) {
+    pid_t pids[jobs];
+    long long deadline = budget_ns ? bench_now_ns() + budget_ns : 0;
+
+    memset(sh, 0, sizeof(*sh));
+    sh->failed_iter = -1;
+    for (int w = 0; w < jobs; w++) {
+        fflush(stdout);
+        pids[w] = fork();
+        if (pids[w] == 0)
+            fuzz_worker(o, idx, w, jobs, cfg, deadline, sh);
+        if (pids[w] < 0) {
+            perror("libft_test: fork");
+            exit(2);
+        }
+    }
+    for (int left = jobs; left > 0; left--) {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            perror("libft_test: waitpid");
+            exit(2);
+        }
+        if (!WIFSIGNALED(status))
+            continue;
+        for (int w = 0; w < jobs; w++) {
+            if (pids[w] == pid && __sync_bool_compare_and_swap(&sh->stop, 0, 1)) {
+                sh->failed_iter = sh->current[w];
+                describe_signal(o->name, WTERMSIG(status), sh->why, sizeof(sh->why));
+            }
+        }
+    }
+
+    long total = 0;
+    for (int w = 0; w < jobs; w++)
+        total += sh->done[w];
+    if (sh->failed_iter < 0) {
+        printf("  %-10s %10ld inputs " GREEN "✓" RESET "\n", o->name, total);
+        fflush(stdout);
+        return 0;
+    }
+
+    t_fuzz_input in;
+    generate(cfg->seed, idx, sh->failed_iter, &in);
+    printf(RED "  %-10s ✗ diverged on input #%ld" RESET "\n", o->name, sh->failed_iter);
+    printf(YELLOW "    %s" RESET "\n", sh->why);
+    fflush(stdout);
+    minimize(o, &in, sh);
+    printf("    minimized reproducer:\n");
+    printf(YELLOW "      %s" RESET "\n", sh->why);
+    print_bytes("a", in.a, in.alen);
+    print_bytes("b", in.b, in.blen);
+    print_size("n", in.n);
+    print_size("off", in.off);
+    printf("      %-4s = %d\n", "c", in.c);
+    printf("    rerun with: --fuzz --seed=%lu --bench-only=%s\n", cfg->seed, o->name);
+    fflush(stdout);
+    return 1;
+}
+
+/* Compare ft_* functions with libc/BSD on generated inputs, stopping at
+ * the first divergence */
+int run_fuzz(const t_fuzz_config *cfg) {
+    int jobs = cfg->jobs < 1 ? 1 : (cfg->jobs > FUZZ_MAX_WORKERS ? FUZZ_MAX_WORKERS : cfg->jobs);
+    int selected = 0;
+
+    for (int i = 0; i < g_noracles; i++)
+        selected += !cfg->only || strcmp(cfg->only, g_oracles[i].name) == 0;
+    if (selected == 0) {
+        fprintf(stderr, "libft_test: no fuzz oracle for %s\n", cfg->only);
+        return 2;
+    }
+    t_fuzz_shared *sh = mmap(NULL, sizeof(t_fuzz_shared), PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sh == MAP_FAILED) {
+        perror("libft_test: mmap");
+        return 2;
+    }
+    long long budget_ns = cfg->time_ms > 0 ? cfg->time_ms * 1000000LL / selected : 0;
+
+    printf(BOLD CYAN "\n=== Differential fuzzing (seed %lu, %d worker%s) ===" RESET "\n",
+           cfg->seed, jobs, jobs == 1 ? "" : "s");
+    int failed = 0;
+    for (int i = 0; i < g_noracles && !failed; i++) {
+        if (cfg->only && strcmp(cfg->only, g_oracles[i].name) != 0)
+            continue;
+        failed = fuzz_function(&g_oracles[i], i, jobs, cfg, budget_ns, sh);
+    }
+    munmap(sh, sizeof(t_fuzz_shared));
+    return failed;
+}
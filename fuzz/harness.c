@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../tester.h"
+
+/*
+ * libFuzzer entry point for one family of ft_* functions. Built once per
+ * family by `make fuzz`, e.g. with -DFUZZ_FAMILY="\"mem\"", and checked
+ * with the same oracles as `libft_test --fuzz` (oracle.c).
+ *
+ * Input layout (missing bytes read as zero):
+ *   [0]       which function of the family
+ *   [1..8]    n, little endian
+ *   [9..16]   off, little endian
+ *   [17..20]  c, little endian
+ *   [21]      where the rest is split between a and b (0..255)
+ *   [22..]    a, then b
+ *
+ * Build with -DFUZZ_REPLAY instead of -fsanitize=fuzzer to get a plain
+ * program that runs the files given on its command line once each.
+ */
+
+#ifndef FUZZ_FAMILY
+# error "build with -DFUZZ_FAMILY=\"\\\"mem\\\"\" (or str, conv, alloc)"
+#endif
+
+#define HEADER_SIZE 22
+
+/* Huge ft_calloc requests must come back NULL, not abort under ASan */
+const char *__asan_default_options(void) {
+    return "allocator_may_return_null=1";
+}
+
+static uint64_t read_le(const uint8_t *p, int n) {
+    uint64_t v = 0;
+    for (int i = n - 1; i >= 0; i--)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+static size_t min_size(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+/* Turn raw fuzzer bytes into a function selector and an oracle input */
+static unsigned decode(const uint8_t *data, size_t size, t_fuzz_input *in) {
+    uint8_t header[HEADER_SIZE] = { 0 };
+    size_t h = min_size(size, HEADER_SIZE);
+
+    memcpy(header, data, h);
+    data += h;
+    size -= h;
+    in->n = (size_t)read_le(header + 1, 8);
+    in->off = (size_t)read_le(header + 9, 8);
+    in->c = (int)(uint32_t)read_le(header + 17, 4);
+    size_t split = size * header[21] / 255;
+    in->alen = min_size(split, FUZZ_MAX_LEN);
+    memcpy(in->a, data, in->alen);
+    in->blen = min_size(size - split, FUZZ_MAX_LEN);
+    memcpy(in->b, data + split, in->blen);
+    return header[0];
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static const t_oracle *family[64];
+    static int count = -1;
+    t_fuzz_input in;
+    char why[256];
+
+    if (count < 0) {
+        count = 0;
+        for (int i = 0; i < g_noracles && count < 64; i++) {
+            if (strcmp(g_oracles[i].family, FUZZ_FAMILY) == 0)
+                family[count++] = &g_oracles[i];
+        }
+    }
+    if (count == 0)
+        return 0;
+    const t_oracle *o = family[decode(data, size, &in) % count];
+    if (!o->check(&in, why, sizeof(why))) {
+        fprintf(stderr, "%s\n", why);
+        abort();
+    }
+    return 0;
+}
+
+#ifdef FUZZ_REPLAY
+/* Replay corpus files or crash reproducers without libFuzzer */
+int main(int argc, char **argv) {
+    static uint8_t buf[1 << 16];
+
+    for (int i = 1; i < argc; i++) {
+        FILE *f = fopen(argv[i], "rb");
+        if (!f) {
+            perror(argv[i]);
+            return 2;
+        }
+        size_t size = fread(buf, 1, sizeof(buf), f);
+        fclose(f);
+        LLVMFuzzerTestOneInput(buf, size);
+    }
+    printf("%d input%s OK\n", argc - 1, argc == 2 ? "" : "s");
+    return 0;
+}
+#endif
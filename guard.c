@@ -0,0 +1,83 @@
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "tester.h"
+
+/*
+ * Test inputs placed flush against a PROT_NONE page, so that reading or
+ * writing one byte outside them faults at once and the test is counted
+ * as a segfault. Each buffer gets its own mapping with a guard page on
+ * both sides; `edge` picks which side the buffer touches.
+ */
+
+#define GUARD_MAX 64
+
+typedef struct {
+    void *ptr;
+    void *base;
+    size_t len;
+} t_guard_region;
+
+static t_guard_region g_regions[GUARD_MAX];
+
+/* `n` bytes ending right before (GUARD_TAIL) or starting right after
+ * (GUARD_HEAD) an inaccessible page. NULL if out of mappings */
+void *guard_alloc(size_t n, t_guard_edge edge) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t data = (n + page - 1) / page * page;
+    int slot = 0;
+
+    while (slot < GUARD_MAX && g_regions[slot].ptr)
+        slot++;
+    if (slot == GUARD_MAX)
+        return NULL;
+    size_t len = data + 2 * page;
+    char *base = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return NULL;
+    if (mprotect(base, page, PROT_NONE) != 0
+        || mprotect(base + page + data, page, PROT_NONE) != 0) {
+        munmap(base, len);
+        return NULL;
+    }
+    char *p = edge == GUARD_HEAD ? base + page : base + page + data - n;
+    g_regions[slot] = (t_guard_region){ p, base, len };
+    return p;
+}
+
+/* Copy of `s` whose terminating NUL is the last readable byte */
+char *guard_strdup(const char *s) {
+    size_t n = strlen(s) + 1;
+    char *p = guard_alloc(n, GUARD_TAIL);
+    if (p)
+        memcpy(p, s, n);
+    return p;
+}
+
+/* Copy of `n` bytes with nothing readable after them: no NUL either */
+void *guard_memdup(const void *src, size_t n) {
+    void *p = guard_alloc(n, GUARD_TAIL);
+    if (p)
+        memcpy(p, src, n);
+    return p;
+}
+
+/* Unmap every buffer, e.g. those of a test abandoned after a fault */
+void guard_reset(void) {
+    for (int i = 0; i < GUARD_MAX; i++) {
+        if (g_regions[i].ptr)
+            munmap(g_regions[i].base, g_regions[i].len);
+        g_regions[i].ptr = NULL;
+    }
+}
+
+void guard_free(void *p) {
+    for (int i = 0; p && i < GUARD_MAX; i++) {
+        if (g_regions[i].ptr == p) {
+            munmap(g_regions[i].base, g_regions[i].len);
+            g_regions[i].ptr = NULL;
+            return;
+        }
+    }
+}
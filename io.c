@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "tester.h"
+#include "ftable.h"
+
+/*
+ * write() interposer for the ft_put*_fd family. libft_test is linked with
+ * -Wl,--wrap=write, so libft's write() calls land in __wrap_write() below;
+ * ftable.c points a --lib library's write() at it too. Between io_begin()
+ * and io_end() every call and its size is recorded. run_io_profile() uses
+ * that to report how many bytes each syscall carries, for --io.
+ */
+
+ssize_t __real_write(int fd, const void *buf, size_t n);
+
+static int g_io_tracking = 0;
+static t_io_stats g_io;
+
+ssize_t __wrap_write(int fd, const void *buf, size_t n) {
+    if (g_io_tracking) {
+        if (g_io.writes < IO_MAX_SIZES)
+            g_io.sizes[g_io.writes] = n;
+        if (g_io.writes == 0 || n < g_io.min)
+            g_io.min = n;
+        if (n > g_io.max)
+            g_io.max = n;
+        g_io.writes++;
+        g_io.bytes += n;
+    }
+    return __real_write(fd, buf, n);
+}
+
+/* Start recording write() calls */
+void io_begin(void) {
+    memset(&g_io, 0, sizeof(g_io));
+    g_io_tracking = 1;
+}
+
+/* Stop recording and hand back what was written since io_begin() */
+void io_end(t_io_stats *out) {
+    g_io_tracking = 0;
+    if (out)
+        *out = g_io;
+}
+
+/* Profile: each function on a range of inputs, as a logging path would */
+#define IO_TIME_NS     50000000LL  /* time each row for about this long */
+#define IO_LONG_LEN    (1UL << 20)
+#define IO_PER_BYTE    2.0         /* fewer bytes per syscall than this is flagged */
+#define IO_CHILD_LIMIT 60
+
+typedef struct {
+    const char *function;
+    const char *input;
+    void (*put)(int fd);
+} t_io_case;
+
+static char *g_io_text = NULL;     /* the longest input; shorter ones are prefixes */
+
+static void put_text(int fd, size_t len) {
+    char saved = g_io_text[len];
+    g_io_text[len] = '\0';
+    ft_putstr_fd(g_io_text, fd);
+    g_io_text[len] = saved;
+}
+
+static void endl_text(int fd, size_t len) {
+    char saved = g_io_text[len];
+    g_io_text[len] = '\0';
+    ft_putendl_fd(g_io_text, fd);
+    g_io_text[len] = saved;
+}
+
+static void io_str_1(int fd) { put_text(fd, 1); }
+static void io_str_16(int fd) { put_text(fd, 16); }
+static void io_str_80(int fd) { put_text(fd, 80); }
+static void io_str_4k(int fd) { put_text(fd, 4096); }
+static void io_str_1m(int fd) { put_text(fd, IO_LONG_LEN); }
+static void io_endl_0(int fd) { endl_text(fd, 0); }
+static void io_endl_80(int fd) { endl_text(fd, 80); }
+static void io_endl_4k(int fd) { endl_text(fd, 4096); }
+static void io_nbr_0(int fd) { ft_putnbr_fd(0, fd); }
+static void io_nbr_42(int fd) { ft_putnbr_fd(-42, fd); }
+static void io_nbr_max(int fd) { ft_putnbr_fd(INT_MAX, fd); }
+static void io_nbr_min(int fd) { ft_putnbr_fd(INT_MIN, fd); }
+
+static const t_io_case g_io_cases[] = {
+    { "ft_putstr_fd",  "1 char",       io_str_1 },
+    { "ft_putstr_fd",  "16 chars",     io_str_16 },
+    { "ft_putstr_fd",  "80 chars",     io_str_80 },
+    { "ft_putstr_fd",  "4 KiB",        io_str_4k },
+    { "ft_putstr_fd",  "1 MiB",        io_str_1m },
+    { "ft_putendl_fd", "empty",        io_endl_0 },
+    { "ft_putendl_fd", "80 chars",     io_endl_80 },
+    { "ft_putendl_fd", "4 KiB",        io_endl_4k },
+    { "ft_putnbr_fd",  "0",            io_nbr_0 },
+    { "ft_putnbr_fd",  "-42",          io_nbr_42 },
+    { "ft_putnbr_fd",  "INT_MAX",      io_nbr_max },
+    { "ft_putnbr_fd",  "INT_MIN",      io_nbr_min },
+};
+#define NIO_CASES (int)(sizeof(g_io_cases) / sizeof(g_io_cases[0]))
+
+/* "6", "11 x 1", or the first few sizes when they differ */
+static void format_sizes(const t_io_stats *io, char *buf, size_t len) {
+    if (io->writes == 0) {
+        snprintf(buf, len, "-");
+    } else if (io->min == io->max) {
+        if (io->writes == 1)
+            snprintf(buf, len, "%zu", io->min);
+        else
+            snprintf(buf, len, "%ld x %zu", io->writes, io->min);
+    } else {
+        size_t off = 0;
+        for (long i = 0; i < io->writes && i < IO_MAX_SIZES && off < len; i++)
+            off += snprintf(buf + off, len - off, "%s%zu", i ? "+" : "", io->sizes[i]);
+        if (io->writes > IO_MAX_SIZES && off < len)
+            snprintf(buf + off, len - off, "+...");
+    }
+}
+
+/* Time one call writing to /dev/null, repeated for about IO_TIME_NS */
+static double ns_per_call(void (*put)(int fd), int null_fd) {
+    long calls = 0;
+    long long start = bench_now_ns();
+    long long elapsed;
+
+    do {
+        put(null_fd);
+        calls++;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < IO_TIME_NS);
+    return (double)elapsed / calls;
+}
+
+/* Print one row; returns 1 if its writes are too small. Runs in a child */
+static int profile_case(const t_io_case *c, int null_fd) {
+    t_capture cap;
+    t_io_stats io;
+    char sizes[64];
+
+    if (!capture_begin(&cap))
+        return 0;
+    io_begin();
+    c->put(cap.fd);
+    io_end(&io);
+    capture_end(&cap);
+
+    /* The kernel's count also sees writev() or a raw syscall() */
+    long syscalls = cap.writes >= 0 ? cap.writes : io.writes;
+    double per_call = syscalls > 0 ? (double)cap.len / syscalls : 0;
+    int per_byte = cap.len > 1 && per_call < IO_PER_BYTE;
+    format_sizes(&io, sizes, sizeof(sizes));
+    printf("  %-14s %-9s %8zu %9ld %10.1f  %-22s %10.0f   %s\n", c->function, c->input,
+           cap.len, syscalls, per_call, sizes, ns_per_call(c->put, null_fd),
+           per_byte ? RED "PER-BYTE" RESET : GREEN "ok" RESET);
+    capture_free(&cap);
+    fflush(stdout);
+    return per_byte;
+}
+
+/* Count the write() calls of ft_putstr_fd, ft_putendl_fd and ft_putnbr_fd
+ * and how many bytes each one carries */
+int run_io_profile(const t_bench_config *cfg) {
+    int null_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    int flagged = 0;
+
+    g_io_text = malloc(IO_LONG_LEN + 1);
+    if (null_fd < 0 || !g_io_text) {
+        perror("libft_test: io");
+        return 2;
+    }
+    for (size_t i = 0; i < IO_LONG_LEN; i++)
+        g_io_text[i] = (char)('a' + i % 26);
+    g_io_text[IO_LONG_LEN] = '\0';
+
+    printf(BOLD CYAN "\n=== write() profile of the put*_fd functions ===" RESET "\n");
+    printf(BOLD "  %-14s %-9s %8s %9s %10s  %-22s %10s   %s" RESET "\n", "function", "input",
+           "bytes", "syscalls", "B/syscall", "write() sizes", "ns/call", "verdict");
+    for (int i = 0; i < NIO_CASES; i++) {
+        const t_io_case *c = &g_io_cases[i];
+        if (cfg->only && strcmp(cfg->only, c->function) != 0)
+            continue;
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            alarm(IO_CHILD_LIMIT);
+            exit(profile_case(c, null_fd));
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+            perror("libft_test: io");
+            flagged++;
+        } else if (WIFSIGNALED(status)) {
+            printf(RED "  %-14s %-9s %s" RESET "\n", c->function, c->input,
+                   WTERMSIG(status) == SIGALRM ? "TIMEOUT" : strsignal(WTERMSIG(status)));
+            flagged++;
+        } else if (WEXITSTATUS(status) != 0) {
+            flagged++;
+        }
+    }
+    free(g_io_text);
+    close(null_fd);
+    return flagged ? 1 : 0;
+}
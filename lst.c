@@ -0,0 +1,249 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "tester.h"
+
+/*
+ * Scaling check of the bonus t_list functions (BONUS=1 builds only):
+ * each function runs on lists of 10^6 to 10^7 nodes in its own child, and
+ * the growth exponent of its time is fitted as in complexity.c. Inputs are
+ * built and freed with plain malloc/free so that a broken function only
+ * affects its own row.
+ */
+
+#define LST_REPS         3
+#define LST_APPENDS      16           /* ft_lstadd_back calls per run */
+#define LST_STOP_NS      2000000000LL /* stop growing once one run takes this long */
+#define LST_CHILD_LIMIT  60           /* seconds before a whole function is killed */
+#define LST_STACK_LIMIT  (8UL << 20)  /* the usual default, so recursion fails the same everywhere */
+
+#define LST_SPARE_N      ((size_t)-1) /* as many spare nodes as list nodes */
+
+static const size_t g_lst_sizes[] = { 1000000, 2000000, 5000000, 10000000 };
+#define NLST_SIZES (int)(sizeof(g_lst_sizes) / sizeof(g_lst_sizes[0]))
+
+/* A list of n nodes plus `nspare` unlinked nodes for the adding functions */
+typedef struct {
+    t_list *head;
+    t_list **spare;
+    size_t nspare;
+} t_lst_input;
+
+/* One function: what to build for it and the call to time */
+typedef struct {
+    const char *name;
+    const char *unit;             /* what the time column covers */
+    size_t linked;                /* 0: no list, 1: a list of n nodes */
+    size_t spare;                 /* unlinked nodes, or LST_SPARE_N */
+    void (*run)(t_lst_input *in, size_t n);
+} t_lst_case;
+
+static long g_lst_sink = 0;
+
+static void lst_free_nodes(t_list *l) {
+    while (l) {
+        t_list *next = l->next;
+        free(l);
+        l = next;
+    }
+}
+
+static void free_lst_input(t_lst_input *in) {
+    lst_free_nodes(in->head);
+    free(in->spare);
+    free(in);
+}
+
+static t_lst_input *new_lst_input(const t_lst_case *c, size_t n) {
+    t_lst_input *in = calloc(1, sizeof(*in));
+    if (!in)
+        return NULL;
+    for (size_t i = 0; c->linked && i < n; i++) {
+        t_list *node = malloc(sizeof(*node));
+        if (!node) {
+            free_lst_input(in);
+            return NULL;
+        }
+        node->content = (void *)(i + 1);
+        node->next = in->head;
+        in->head = node;
+    }
+    in->nspare = c->spare == LST_SPARE_N ? n : c->spare;
+    in->spare = malloc(in->nspare * sizeof(*in->spare));
+    if (!in->spare) {
+        free_lst_input(in);
+        return NULL;
+    }
+    for (size_t i = 0; i < in->nspare; i++) {
+        in->spare[i] = malloc(sizeof(t_list));
+        if (!in->spare[i]) {
+            while (i > 0)
+                free(in->spare[--i]);
+            free_lst_input(in);
+            return NULL;
+        }
+        in->spare[i]->content = NULL;
+        in->spare[i]->next = NULL;
+    }
+    return in;
+}
+
+static void del_none(void *content) {
+    (void)content;
+}
+
+static void iter_count(void *content) {
+    g_lst_sink += (long)content;
+}
+
+static void *map_same(void *content) {
+    return content;
+}
+
+/* Building a list of n nodes: n O(1) calls */
+static void run_add_front(t_lst_input *in, size_t n) {
+    (void)n;
+    for (size_t i = 0; i < in->nspare; i++)
+        ft_lstadd_front(&in->head, in->spare[i]);
+}
+
+/* A few appends to a list of n nodes: each one walks it once. Building a
+ * whole list this way is quadratic by nature, but no single call may be */
+static void run_add_back(t_lst_input *in, size_t n) {
+    (void)n;
+    for (size_t i = 0; i < in->nspare; i++)
+        ft_lstadd_back(&in->head, in->spare[i]);
+}
+
+static void run_size(t_lst_input *in, size_t n) {
+    if ((size_t)ft_lstsize(in->head) != n)
+        abort();
+}
+
+static void run_last(t_lst_input *in, size_t n) {
+    (void)n;
+    g_lst_sink += (long)ft_lstlast(in->head)->content;
+}
+
+static void run_iter(t_lst_input *in, size_t n) {
+    (void)n;
+    ft_lstiter(in->head, iter_count);
+}
+
+static void run_map(t_lst_input *in, size_t n) {
+    (void)n;
+    lst_free_nodes(ft_lstmap(in->head, map_same, del_none));
+}
+
+static void run_clear(t_lst_input *in, size_t n) {
+    (void)n;
+    ft_lstclear(&in->head, del_none);
+}
+
+static const t_lst_case g_lst_cases[] = {
+    { "ft_lstadd_front", "n calls",   0, LST_SPARE_N, run_add_front },
+    { "ft_lstadd_back",  "16 calls",  1, LST_APPENDS, run_add_back },
+    { "ft_lstsize",      "1 call",    1, 0,           run_size },
+    { "ft_lstlast",      "1 call",    1, 0,           run_last },
+    { "ft_lstiter",      "1 call",    1, 0,           run_iter },
+    { "ft_lstmap",       "1 call",    1, 0,           run_map },
+    { "ft_lstclear",     "1 call",    1, 0,           run_clear },
+};
+#define NLST_CASES (int)(sizeof(g_lst_cases) / sizeof(g_lst_cases[0]))
+
+/* Time one function over the list sizes and print its row; runs in a child */
+static int check_lst_function(const t_lst_case *c) {
+    double sizes[NLST_SIZES];
+    double times[NLST_SIZES];
+    int npoints = 0;
+
+    for (int s = 0; s < NLST_SIZES; s++) {
+        size_t n = g_lst_sizes[s];
+        long long best = 0;
+        for (int r = 0; r < LST_REPS; r++) {
+            t_lst_input *in = new_lst_input(c, n);
+            if (!in)
+                break;
+            long long start = bench_now_ns();
+            c->run(in, n);
+            long long elapsed = bench_now_ns() - start;
+            free_lst_input(in);
+            if (r == 0 || elapsed < best)
+                best = elapsed;
+            /* The first run also faults in fresh heap pages: always retry */
+            if (r > 0 && elapsed > LST_STOP_NS)
+                break;
+        }
+        if (best == 0)
+            break;
+        sizes[npoints] = (double)n;
+        times[npoints] = (double)best;
+        npoints++;
+        if (best > LST_STOP_NS)
+            break;
+    }
+    if (npoints == 0) {
+        printf(YELLOW "  %-15s could not allocate a list of %zu nodes" RESET "\n",
+               c->name, g_lst_sizes[0]);
+        return 0;
+    }
+
+    double k = npoints >= 2 ? fit_exponent(sizes, times, npoints) : 0;
+    const char *verdict = GREEN "linear" RESET;
+    if (k >= CPLX_QUADRATIC)
+        verdict = RED "QUADRATIC (expected linear)" RESET;
+    else if (k > CPLX_LINEAR)
+        verdict = YELLOW "superlinear" RESET;
+    printf("  %-15s %10zu %-9s %12.3f %9.1f %7.2f   %s\n", c->name, (size_t)sizes[npoints - 1],
+           c->unit, times[npoints - 1] / 1e6, times[npoints - 1] / sizes[npoints - 1], k, verdict);
+    fflush(stdout);
+    return k >= CPLX_QUADRATIC ? 1 : 0;
+}
+
+/* Flag t_list functions that are quadratic or recurse once per node */
+int run_lst_bench(const t_bench_config *cfg) {
+    int flagged = 0;
+
+    printf(BOLD CYAN "\n=== t_list scaling (10^6 .. 10^7 nodes, time ~ n^k) ===" RESET "\n");
+    printf(BOLD "  %-15s %10s %-9s %12s %9s %7s   %s" RESET "\n",
+           "function", "max n", "timed", "time (ms)", "ns/node", "k", "verdict");
+    for (int i = 0; i < NLST_CASES; i++) {
+        const t_lst_case *c = &g_lst_cases[i];
+        if (cfg->only && strcmp(cfg->only, c->name) != 0)
+            continue;
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            struct rlimit stack;
+            if (getrlimit(RLIMIT_STACK, &stack) == 0 && stack.rlim_max >= LST_STACK_LIMIT) {
+                stack.rlim_cur = LST_STACK_LIMIT;
+                setrlimit(RLIMIT_STACK, &stack);
+            }
+            alarm(LST_CHILD_LIMIT);
+            exit(check_lst_function(c));
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+            perror("libft_test: lst-bench");
+            flagged++;
+        } else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+            printf(RED "  %-15s TIMEOUT after %d s (far worse than linear)" RESET "\n",
+                   c->name, LST_CHILD_LIMIT);
+            flagged++;
+        } else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV) {
+            printf(RED "  %-15s SEGFAULT: recursing once per node overflows the %lu MiB stack" RESET "\n",
+                   c->name, LST_STACK_LIMIT >> 20);
+            flagged++;
+        } else if (WIFSIGNALED(status)) {
+            printf(RED "  %-15s crashed: %s" RESET "\n", c->name, strsignal(WTERMSIG(status)));
+            flagged++;
+        } else if (WEXITSTATUS(status) != 0) {
+            flagged++;
+        }
+    }
+    return flagged ? 1 : 0;
+}
@@ -5,88 +5,10 @@
 #include <unistd.h>
 #include <sys/wait.h>
 #include <setjmp.h>
-#include "libft/libft.h"
-
-/* Color codes for output */
-#define RED     "\033[31m"
-#define GREEN   "\033[32m"
-#define YELLOW  "\033[33m"
-#define BLUE    "\033[34m"
-#define MAGENTA "\033[35m"
-#define CYAN    "\033[36m"
-#define RESET   "\033[0m"
-#define BOLD    "\033[1m"
-
-/* Test statistics */
-typedef struct {
-    int total;
-    int passed;
-    int failed;
-    int segfaults;
-} t_stats;
-
-static t_stats g_stats = {0, 0, 0, 0};
-static char *g_current_test = NULL;
-
-/* Signal handler for segfaults */
-void segfault_handler(int sig) {
-    if (sig == SIGSEGV) {
-        printf(RED "    ✗ SEGFAULT detected in test: %s" RESET "\n", 
-               g_current_test ? g_current_test : "Unknown test");
-        g_stats.segfaults++;
-        g_stats.failed++;
-        exit(1);
-    }
-}
-
-/* Print test header */
-void print_header(const char *function_name) {
-    printf(BOLD CYAN "\n=== Testing %s ===" RESET "\n", function_name);
-}
-
-/* Print test result */
-void print_result(const char *test_name, int passed, const char *expected, const char *got) {
-    g_stats.total++;
-    if (passed) {
-        printf(GREEN "  ✓ %s" RESET "\n", test_name);
-        g_stats.passed++;
-    } else {
-        printf(RED "  ✗ %s" RESET "\n", test_name);
-        if (expected && got) {
-            printf(YELLOW "    Expected: %s" RESET "\n", expected);
-            printf(YELLOW "    Got:      %s" RESET "\n", got);
-        }
-        g_stats.failed++;
-    }
-}
-
-/* Safe test execution with fork to catch segfaults */
-int safe_test(const char *test_name, int (*test_func)(void)) {
-    g_current_test = (char *)test_name;
-    
-    pid_t pid = fork();
-    if (pid == 0) {
-        /* Child process */
-        signal(SIGSEGV, segfault_handler);
-        int result = test_func();
-        exit(result ? 0 : 1);
-    } else if (pid > 0) {
-        /* Parent process */
-        int status;
-        waitpid(pid, &status, 0);
-        
-        if (WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV) {
-            print_result(test_name, 0, "No segfault", "SEGFAULT");
-            g_stats.segfaults++;
-            return 0;
-        } else if (WIFEXITED(status)) {
-            int result = (WEXITSTATUS(status) == 0);
-            print_result(test_name, result, NULL, NULL);
-            return result;
-        }
-    }
-    return 0;
-}
+#include <time.h>
+#include <limits.h>
+#include "tester.h"
+#include "ftable.h"
 
 /* Test functions for ft_strlen */
 int test_ft_strlen_basic(void) {
@@ -111,6 +33,15 @@ int test_ft_strlen_long(void) {
     return result;
 }
 
+/* The NUL is the last readable byte: reading past it faults */
+int test_ft_strlen_guarded(void) {
+    char *s = guard_strdup("Hello");
+    if (!s) return 0;
+    int result = (ft_strlen(s) == 5);
+    guard_free(s);
+    return result;
+}
+
 /* Test functions for ft_strchr */
 int test_ft_strchr_found(void) {
     char *str = "Hello World";
@@ -232,6 +163,20 @@ int test_ft_memmove_null(void) {
     return 1;
 }
 
+/* Both copy directions on a buffer that starts at a guard page: an
+ * off-by-one backward copy reads or writes the byte before it */
+int test_ft_memmove_guarded(void) {
+    char *buf = guard_alloc(9, GUARD_HEAD);
+    if (!buf) return 0;
+    memcpy(buf, "123456789", 9);
+    ft_memmove(buf + 3, buf, 6);
+    int result = (memcmp(buf, "123123456", 9) == 0);
+    ft_memmove(buf, buf + 3, 6);
+    result = result && memcmp(buf, "123456456", 9) == 0;
+    guard_free(buf);
+    return result;
+}
+
 /* Test functions for ft_memchr */
 int test_ft_memchr_found(void) {
     char str[] = "Hello World";
@@ -248,6 +193,15 @@ int test_ft_memchr_null(void) {
     return ft_memchr(NULL, 'a', 5) == NULL; /* Will segfault */
 }
 
+/* Nothing readable after the n bytes, not even a NUL */
+int test_ft_memchr_guarded(void) {
+    char *buf = guard_memdup("Hello World", 11);
+    if (!buf) return 0;
+    int result = (ft_memchr(buf, 'z', 11) == NULL && ft_memchr(buf, 'd', 11) == buf + 10);
+    guard_free(buf);
+    return result;
+}
+
 /* Test functions for ft_memcmp */
 int test_ft_memcmp_equal(void) {
     return ft_memcmp("Hello", "Hello", 5) == 0;
@@ -267,6 +221,15 @@ int test_ft_memcmp_null(void) {
     return 1;
 }
 
+int test_ft_memcmp_guarded(void) {
+    char *a = guard_memdup("Hello", 5);
+    char *b = guard_memdup("Hello", 5);
+    int result = (a && b && ft_memcmp(a, b, 5) == 0);
+    guard_free(a);
+    guard_free(b);
+    return result;
+}
+
 /* Test functions for ft_strlcpy */
 int test_ft_strlcpy_basic(void) {
     char dst[10];
@@ -285,6 +248,21 @@ int test_ft_strlcpy_null_dst(void) {
     return 1;
 }
 
+/* dst is exactly dstsize bytes and src ends at its NUL */
+int test_ft_strlcpy_guarded(void) {
+    char *src = guard_strdup("Hello");
+    char *dst = guard_alloc(4, GUARD_TAIL);
+    int result = 0;
+    if (src && dst) {
+        size_t n = ft_strlcpy(dst, src, 4);
+        result = (n == 5 && strcmp(dst, "Hel") == 0);
+        result = result && ft_strlcpy(dst, src, 0) == 5;
+    }
+    guard_free(src);
+    guard_free(dst);
+    return result;
+}
+
 /* Test functions for ft_strlcat */
 int test_ft_strlcat_basic(void) {
     char dst[20] = "Hello ";
@@ -303,6 +281,21 @@ int test_ft_strlcat_null(void) {
     return 1;
 }
 
+/* dst is exactly dstsize bytes and src ends at its NUL */
+int test_ft_strlcat_guarded(void) {
+    char *src = guard_strdup("World");
+    char *dst = guard_alloc(10, GUARD_TAIL);
+    int result = 0;
+    if (src && dst) {
+        memcpy(dst, "Hello ", 7);
+        size_t n = ft_strlcat(dst, src, 10);
+        result = (n == 11 && strcmp(dst, "Hello Wor") == 0);
+    }
+    guard_free(src);
+    guard_free(dst);
+    return result;
+}
+
 /* Test functions for ft_strrchr */
 int test_ft_strrchr_found(void) {
     char *str = "Hello World";
@@ -356,6 +349,22 @@ int test_ft_strnstr_null(void) {
     return ft_strnstr(NULL, "test", 5) == NULL; /* Will segfault */
 }
 
+/* The haystack is exactly len bytes with no NUL: nothing past len may
+ * be read */
+int test_ft_strnstr_guarded(void) {
+    char *hay = guard_memdup("Hello World", 11);
+    char *needle = guard_strdup("World");
+    int result = 0;
+    if (hay && needle) {
+        result = (ft_strnstr(hay, needle, 11) == hay + 6);
+        result = result && ft_strnstr(hay, "Worlds", 11) == NULL;
+        result = result && ft_strnstr(hay, "xyz", 11) == NULL;
+    }
+    guard_free(hay);
+    guard_free(needle);
+    return result;
+}
+
 /* Test functions for ft_atoi */
 int test_ft_atoi_positive(void) {
     return ft_atoi("123") == 123;
@@ -378,71 +387,107 @@ int test_ft_atoi_null(void) {
     return 1;
 }
 
-/* Test functions for ft_isalpha */
-int test_ft_isalpha_letter(void) {
-    return (ft_isalpha('a') && ft_isalpha('Z'));
-}
-
-int test_ft_isalpha_digit(void) {
-    return (!ft_isalpha('5'));
-}
-
-int test_ft_isalpha_special(void) {
-    return (!ft_isalpha('@'));
-}
-
-/* Test functions for ft_isdigit */
-int test_ft_isdigit_digit(void) {
-    return (ft_isdigit('0') && ft_isdigit('9'));
-}
-
-int test_ft_isdigit_letter(void) {
-    return (!ft_isdigit('a'));
-}
-
-/* Test functions for ft_isalnum */
-int test_ft_isalnum_alphanum(void) {
-    return (ft_isalnum('a') && ft_isalnum('5'));
-}
-
-int test_ft_isalnum_special(void) {
-    return (!ft_isalnum('@'));
-}
-
-/* Test functions for ft_isascii */
-int test_ft_isascii_valid(void) {
-    return (ft_isascii(0) && ft_isascii(127));
-}
-
-int test_ft_isascii_invalid(void) {
-    return (!ft_isascii(128));
-}
-
-/* Test functions for ft_isprint */
-int test_ft_isprint_printable(void) {
-    return (ft_isprint(' ') && ft_isprint('~'));
-}
-
-int test_ft_isprint_non_printable(void) {
-    return (!ft_isprint('\t'));
-}
-
-/* Test functions for ft_toupper */
-int test_ft_toupper_lower(void) {
-    return (ft_toupper('a') == 'A');
-}
-
-int test_ft_toupper_upper(void) {
-    return (ft_toupper('A') == 'A');
-}
-
-/* Test functions for ft_tolower */
-int test_ft_tolower_upper(void) {
-    return (ft_tolower('A') == 'a');
-}
-
-int test_ft_tolower_lower(void) {
-    return (ft_tolower('a') == 'a');
+/* Reference table for the ctype functions in the "C" locale, indexed by
+ * c + 1 so that EOF is entry 0. Built entirely by the preprocessor. */
+#define CT_ALPHA  0x01
+#define CT_DIGIT  0x02
+#define CT_ALNUM  0x04
+#define CT_ASCII  0x08
+#define CT_PRINT  0x10
+
+#define CT_UPPER(c) ((c) >= 'A' && (c) <= 'Z')
+#define CT_LOWER(c) ((c) >= 'a' && (c) <= 'z')
+#define CT_DIG(c)   ((c) >= '0' && (c) <= '9')
+#define CT_FLAGS(c) ((CT_UPPER(c) || CT_LOWER(c) ? CT_ALPHA : 0) \
+                     | (CT_DIG(c) ? CT_DIGIT : 0) \
+                     | (CT_UPPER(c) || CT_LOWER(c) || CT_DIG(c) ? CT_ALNUM : 0) \
+                     | ((c) < 128 ? CT_ASCII : 0) \
+                     | ((c) >= 32 && (c) < 127 ? CT_PRINT : 0))
+#define CT_TOUPPER(c) (CT_LOWER(c) ? (c) - 'a' + 'A' : (c))
+#define CT_TOLOWER(c) (CT_UPPER(c) ? (c) - 'A' + 'a' : (c))
+
+#define CT_4(F, c)   F(c), F((c) + 1), F((c) + 2), F((c) + 3)
+#define CT_16(F, c)  CT_4(F, c), CT_4(F, (c) + 4), CT_4(F, (c) + 8), CT_4(F, (c) + 12)
+#define CT_64(F, c)  CT_16(F, c), CT_16(F, (c) + 16), CT_16(F, (c) + 32), CT_16(F, (c) + 48)
+#define CT_256(F)    CT_64(F, 0), CT_64(F, 64), CT_64(F, 128), CT_64(F, 192)
+
+static const unsigned char g_ctype_flags[257] = { 0, CT_256(CT_FLAGS) };
+static const short g_ctype_upper[257] = { EOF, CT_256(CT_TOUPPER) };
+static const short g_ctype_lower[257] = { EOF, CT_256(CT_TOLOWER) };
+
+/* A predicate is checked against one flag, a conversion against a table.
+ * `func` points at the g_ft slot, which --lib fills in at run time */
+typedef struct {
+    const char *name;
+    int (**func)(int);
+    int flag;
+    const short *map;
+} t_ctype_check;
+
+static const t_ctype_check g_ctype_checks[] = {
+    { "ft_isalpha", &ft_isalpha, CT_ALPHA, NULL },
+    { "ft_isdigit", &ft_isdigit, CT_DIGIT, NULL },
+    { "ft_isalnum", &ft_isalnum, CT_ALNUM, NULL },
+    { "ft_isascii", &ft_isascii, CT_ASCII, NULL },
+    { "ft_isprint", &ft_isprint, CT_PRINT, NULL },
+    { "ft_toupper", &ft_toupper, 0, g_ctype_upper },
+    { "ft_tolower", &ft_tolower, 0, g_ctype_lower },
+};
+
+/* Print a code point as EOF, 'a' or 0x80 */
+static void print_code_point(int c) {
+    if (c == EOF)
+        printf("EOF");
+    else if (c > ' ' && c < 127 && c != '\'')
+        printf("'%c'", c);
+    else
+        printf("0x%02x", c);
+}
+
+/* List the inputs a function got wrong, merging consecutive ones */
+static void print_mismatches(const char *name, const unsigned char *bad, int nbad) {
+    printf(YELLOW "    %s is wrong for %d of 257 inputs: ", name, nbad);
+    int first = 1;
+    for (int i = 0; i < 257; i++) {
+        if (!bad[i])
+            continue;
+        int j = i;
+        while (j + 1 < 257 && bad[j + 1])
+            j++;
+        printf("%s", first ? "" : ", ");
+        print_code_point(i - 1);
+        if (j > i) {
+            printf("..");
+            print_code_point(j - 1);
+        }
+        first = 0;
+        i = j;
+    }
+    printf(RESET "\n");
+}
+
+/* Every ctype function on EOF and 0..255 in one pass */
+int test_ft_ctype_table(void) {
+    int ok = 1;
+
+    for (size_t f = 0; f < sizeof(g_ctype_checks) / sizeof(g_ctype_checks[0]); f++) {
+        const t_ctype_check *chk = &g_ctype_checks[f];
+        unsigned char bad[257];
+        int nbad = 0;
+        for (int i = 0; i < 257; i++) {
+            int got = (*chk->func)(i - 1);
+            if (chk->map)
+                bad[i] = got != chk->map[i];
+            else
+                bad[i] = (got != 0) != ((g_ctype_flags[i] & chk->flag) != 0);
+            nbad += bad[i];
+        }
+        if (nbad) {
+            print_mismatches(chk->name, bad, nbad);
+            ok = 0;
+        }
+    }
+    return ok;
 }
 
 /* Test functions for ft_calloc */
@@ -610,350 +655,952 @@ int test_ft_striteri_null(void) {
     return 1;
 }
 
+/* The ft_put*_fd tests write to a capture (capture.c), not to stdout. A
+ * check passes if exactly `len` bytes of `expected` were written and, when
+ * `max_writes` is set, in no more than that many write(2) calls */
+#define PUT_LONG_LEN  (2UL << 20)
+
+static void print_escaped(const char *s, size_t len) {
+    for (size_t i = 0; i < len && i < 32; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '\n')
+            printf("\\n");
+        else if (c >= ' ' && c < 127)
+            printf("%c", c);
+        else
+            printf("\\x%02x", c);
+    }
+    printf("%s", len > 32 ? "..." : "");
+}
+
+static int check_put(void (*put)(int fd), const char *expected, size_t len, long max_writes) {
+    t_capture cap;
+    int ok = 0;
+
+    if (capture_begin(&cap)) {
+        put(cap.fd);
+        ok = capture_end(&cap);
+    }
+    if (!ok) {
+        capture_free(&cap);
+        return 0;
+    }
+    if (cap.len != len || memcmp(cap.data, expected, len) != 0) {
+        printf(YELLOW "    expected %zu bytes \"", len);
+        print_escaped(expected, len);
+        printf("\", got %zu bytes \"", cap.len);
+        print_escaped(cap.data, cap.len);
+        printf("\"" RESET "\n");
+        ok = 0;
+    } else if (max_writes > 0 && cap.writes > max_writes) {
+        printf(YELLOW "    performance: %ld write() calls for %zu bytes%s, expected at most %ld" RESET "\n",
+               cap.writes, len, (size_t)cap.writes >= len ? ", one per byte" : "", max_writes);
+        ok = 0;
+    } else if (max_writes > 0 && cap.writes < 0) {
+        printf(YELLOW "    write() calls not counted: no /proc/self/io" RESET "\n");
+    }
+    capture_free(&cap);
+    return ok;
+}
+
+/* PUT_LONG_LEN bytes of printable text, for put_str_long() */
+static char *g_put_long = NULL;
+
+static char *new_long_string(void) {
+    char *s = malloc(PUT_LONG_LEN + 1);
+    if (s) {
+        for (size_t i = 0; i < PUT_LONG_LEN; i++)
+            s[i] = (char)('a' + i % 26);
+        s[PUT_LONG_LEN] = '\0';
+    }
+    return g_put_long = s;
+}
+
 /* Test functions for ft_putchar_fd */
+static void put_char_a(int fd) { ft_putchar_fd('A', fd); }
+static void put_char_high(int fd) { ft_putchar_fd((char)0xE9, fd); }
+
 int test_ft_putchar_fd_basic(void) {
-    ft_putchar_fd('A', 1); /* Output to stdout */
-    return 1; /* Hard to test output, assume success */
+    return check_put(put_char_a, "A", 1, 0);
+}
+
+int test_ft_putchar_fd_high(void) {
+    return check_put(put_char_high, "\xE9", 1, 0);
+}
+
+int test_ft_putchar_fd_writes(void) {
+    return check_put(put_char_a, "A", 1, 1);
 }
 
 /* Test functions for ft_putstr_fd */
+static void put_str_hello(int fd) { ft_putstr_fd("Hello\n", fd); }
+static void put_str_empty(int fd) { ft_putstr_fd("", fd); }
+static void put_str_null(int fd) { ft_putstr_fd(NULL, fd); }
+static void put_str_long(int fd) { ft_putstr_fd(g_put_long, fd); }
+
 int test_ft_putstr_fd_basic(void) {
-    ft_putstr_fd("Hello\n", 1); /* Output to stdout */
-    return 1; /* Hard to test output, assume success */
+    return check_put(put_str_hello, "Hello\n", 6, 0);
+}
+
+int test_ft_putstr_fd_empty(void) {
+    return check_put(put_str_empty, "", 0, 0);
 }
 
 int test_ft_putstr_fd_null(void) {
-    ft_putstr_fd(NULL, 1); /* May segfault depending on implementation */
+    t_capture cap;
+    if (!capture_begin(&cap)) return 0;
+    put_str_null(cap.fd); /* May segfault depending on implementation */
+    capture_free(&cap);
     return 1;
 }
 
-/* Test functions for ft_putendl_fd */
-int test_ft_putendl_fd_basic(void) {
-    ft_putendl_fd("Hello", 1); /* Output to stdout with newline */
-    return 1; /* Hard to test output, assume success */
+int test_ft_putstr_fd_long(void) {
+    char *s = new_long_string();
+    if (!s) return 0;
+    int success = check_put(put_str_long, s, PUT_LONG_LEN, 0);
+    free(s);
+    return success;
 }
 
-/* Test functions for ft_putnbr_fd */
-int test_ft_putnbr_fd_basic(void) {
-    ft_putnbr_fd(42, 1); /* Output to stdout */
-    printf("\n"); /* Add newline for clarity */
-    return 1; /* Hard to test output, assume success */
+int test_ft_putstr_fd_writes(void) {
+    return check_put(put_str_hello, "Hello\n", 6, 1);
 }
 
-/* Test runner for a specific function */
-void test_ft_strlen(void) {
-    print_header("ft_strlen");
-    safe_test("Basic string length", test_ft_strlen_basic);
-    safe_test("Empty string", test_ft_strlen_empty);
-    safe_test("NULL pointer", test_ft_strlen_null);
-    safe_test("Long string (999 chars)", test_ft_strlen_long);
+/* A 2 MiB string may be split, but not into more than 64 KiB pieces */
+int test_ft_putstr_fd_long_writes(void) {
+    char *s = new_long_string();
+    if (!s) return 0;
+    int success = check_put(put_str_long, s, PUT_LONG_LEN, PUT_LONG_LEN / (64 << 10));
+    free(s);
+    return success;
 }
 
-void test_ft_strchr(void) {
-    print_header("ft_strchr");
-    safe_test("Character found", test_ft_strchr_found);
-    safe_test("Character not found", test_ft_strchr_not_found);
-    safe_test("Null terminator search", test_ft_strchr_null_terminator);
-    safe_test("NULL string", test_ft_strchr_null_string);
-}
+/* Test functions for ft_putendl_fd */
+static void put_endl_hello(int fd) { ft_putendl_fd("Hello", fd); }
+static void put_endl_empty(int fd) { ft_putendl_fd("", fd); }
 
-void test_ft_strdup(void) {
-    print_header("ft_strdup");
-    safe_test("Basic duplication", test_ft_strdup_basic);
-    safe_test("Empty string duplication", test_ft_strdup_empty);
-    safe_test("NULL pointer duplication", test_ft_strdup_null);
+int test_ft_putendl_fd_basic(void) {
+    return check_put(put_endl_hello, "Hello\n", 6, 0);
 }
 
-void test_ft_memset(void) {
-    print_header("ft_memset");
-    safe_test("Basic memset", test_ft_memset_basic);
-    safe_test("Zero length", test_ft_memset_zero_length);
-    safe_test("NULL pointer", test_ft_memset_null);
+int test_ft_putendl_fd_empty(void) {
+    return check_put(put_endl_empty, "\n", 1, 0);
 }
 
-void test_ft_bzero(void) {
-    print_header("ft_bzero");
-    safe_test("Basic bzero", test_ft_bzero_basic);
-    safe_test("Zero length", test_ft_bzero_zero_length);
-    safe_test("NULL pointer", test_ft_bzero_null);
+/* The string and its newline may be written separately */
+int test_ft_putendl_fd_writes(void) {
+    return check_put(put_endl_hello, "Hello\n", 6, 2);
 }
 
-void test_ft_memcpy(void) {
-    print_header("ft_memcpy");
-    safe_test("Basic memcpy", test_ft_memcpy_basic);
-    safe_test("Zero length", test_ft_memcpy_zero_length);
-    safe_test("NULL pointer", test_ft_memcpy_null);
+/* Test functions for ft_putnbr_fd */
+static void put_nbr_42(int fd) { ft_putnbr_fd(42, fd); }
+static void put_nbr_zero(int fd) { ft_putnbr_fd(0, fd); }
+static void put_nbr_negative(int fd) { ft_putnbr_fd(-42, fd); }
+static void put_nbr_int_max(int fd) { ft_putnbr_fd(INT_MAX, fd); }
+static void put_nbr_int_min(int fd) { ft_putnbr_fd(INT_MIN, fd); }
+
+int test_ft_putnbr_fd_basic(void) {
+    return check_put(put_nbr_42, "42", 2, 0);
 }
 
-void test_ft_memmove(void) {
-    print_header("ft_memmove");
-    safe_test("Basic memmove", test_ft_memmove_basic);
-    safe_test("Overlapping memory", test_ft_memmove_overlap);
-    safe_test("NULL pointer", test_ft_memmove_null);
+int test_ft_putnbr_fd_zero(void) {
+    return check_put(put_nbr_zero, "0", 1, 0);
 }
 
-void test_ft_memchr(void) {
-    print_header("ft_memchr");
-    safe_test("Character found", test_ft_memchr_found);
-    safe_test("Character not found", test_ft_memchr_not_found);
-    safe_test("NULL pointer", test_ft_memchr_null);
+int test_ft_putnbr_fd_negative(void) {
+    return check_put(put_nbr_negative, "-42", 3, 0);
 }
 
-void test_ft_memcmp(void) {
-    print_header("ft_memcmp");
-    safe_test("Equal memory", test_ft_memcmp_equal);
-    safe_test("Different memory", test_ft_memcmp_different);
-    safe_test("Zero length", test_ft_memcmp_zero_length);
-    safe_test("NULL pointer", test_ft_memcmp_null);
+int test_ft_putnbr_fd_int_max(void) {
+    return check_put(put_nbr_int_max, "2147483647", 10, 0);
 }
 
-void test_ft_strlcpy(void) {
-    print_header("ft_strlcpy");
-    safe_test("Basic copy", test_ft_strlcpy_basic);
-    safe_test("Truncation", test_ft_strlcpy_truncate);
-    safe_test("NULL destination", test_ft_strlcpy_null_dst);
+int test_ft_putnbr_fd_int_min(void) {
+    return check_put(put_nbr_int_min, "-2147483648", 11, 0);
 }
 
-void test_ft_strlcat(void) {
-    print_header("ft_strlcat");
-    safe_test("Basic concatenation", test_ft_strlcat_basic);
-    safe_test("Truncation", test_ft_strlcat_truncate);
-    safe_test("NULL pointer", test_ft_strlcat_null);
+/* One write per digit is the usual recursive ft_putchar_fd version; the
+ * sign may go out on its own */
+int test_ft_putnbr_fd_writes(void) {
+    return check_put(put_nbr_int_min, "-2147483648", 11, 2);
 }
 
-void test_ft_strrchr(void) {
-    print_header("ft_strrchr");
-    safe_test("Character found", test_ft_strrchr_found);
-    safe_test("Character not found", test_ft_strrchr_not_found);
-    safe_test("NULL string", test_ft_strrchr_null);
+#ifdef BONUS
+/* Helpers for the t_list tests: del callbacks that count their calls */
+static int g_del_calls = 0;
+
+static void test_del_count(void *content) {
+    (void)content;
+    g_del_calls++;
 }
 
-void test_ft_strncmp(void) {
-    print_header("ft_strncmp");
-    safe_test("Equal strings", test_ft_strncmp_equal);
-    safe_test("Different strings", test_ft_strncmp_different);
-    safe_test("Partial comparison", test_ft_strncmp_partial);
-    safe_test("NULL pointer", test_ft_strncmp_null);
+static void test_del_free(void *content) {
+    g_del_calls++;
+    free(content);
 }
 
-void test_ft_strnstr(void) {
-    print_header("ft_strnstr");
-    safe_test("Substring found", test_ft_strnstr_found);
-    safe_test("Substring not found", test_ft_strnstr_not_found);
-    safe_test("Limited by length", test_ft_strnstr_partial_limit);
-    safe_test("NULL pointer", test_ft_strnstr_null);
+/* Link the `n` stack nodes of `nodes` in order, with contents "0", "1"... */
+static t_list *test_stack_list(t_list *nodes, int n) {
+    static char *digits[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9" };
+    for (int i = 0; i < n; i++) {
+        nodes[i].content = digits[i % 10];
+        nodes[i].next = i + 1 < n ? &nodes[i + 1] : NULL;
+    }
+    return n > 0 ? nodes : NULL;
 }
 
-void test_ft_atoi(void) {
-    print_header("ft_atoi");
-    safe_test("Positive number", test_ft_atoi_positive);
-    safe_test("Negative number", test_ft_atoi_negative);
-    safe_test("With whitespace", test_ft_atoi_whitespace);
-    safe_test("Mixed characters", test_ft_atoi_mixed);
-    safe_test("NULL pointer", test_ft_atoi_null);
+/* Test functions for ft_lstnew */
+int test_ft_lstnew_basic(void) {
+    char *content = "Hello";
+    t_list *node = ft_lstnew(content);
+    if (!node) return 0;
+    int success = (node->content == content && node->next == NULL);
+    free(node);
+    return success;
 }
 
-void test_ft_isalpha(void) {
-    print_header("ft_isalpha");
-    safe_test("Letters", test_ft_isalpha_letter);
-    safe_test("Digits", test_ft_isalpha_digit);
-    safe_test("Special characters", test_ft_isalpha_special);
+int test_ft_lstnew_null_content(void) {
+    t_list *node = ft_lstnew(NULL);
+    if (!node) return 0;
+    int success = (node->content == NULL && node->next == NULL);
+    free(node);
+    return success;
 }
 
-void test_ft_isdigit(void) {
-    print_header("ft_isdigit");
-    safe_test("Digits", test_ft_isdigit_digit);
-    safe_test("Letters", test_ft_isdigit_letter);
+/* Test functions for ft_lstadd_front */
+int test_ft_lstadd_front_empty(void) {
+    t_list node = { "new", NULL };
+    t_list *lst = NULL;
+    ft_lstadd_front(&lst, &node);
+    return lst == &node && node.next == NULL;
 }
 
-void test_ft_isalnum(void) {
-    print_header("ft_isalnum");
-    safe_test("Alphanumeric", test_ft_isalnum_alphanum);
-    safe_test("Special characters", test_ft_isalnum_special);
+int test_ft_lstadd_front_basic(void) {
+    t_list nodes[2];
+    t_list node = { "new", NULL };
+    t_list *lst = test_stack_list(nodes, 2);
+    ft_lstadd_front(&lst, &node);
+    return lst == &node && node.next == &nodes[0] && nodes[1].next == NULL;
 }
 
-void test_ft_isascii(void) {
-    print_header("ft_isascii");
-    safe_test("Valid ASCII", test_ft_isascii_valid);
-    safe_test("Invalid ASCII", test_ft_isascii_invalid);
+/* Test functions for ft_lstadd_back */
+int test_ft_lstadd_back_empty(void) {
+    t_list node = { "new", NULL };
+    t_list *lst = NULL;
+    ft_lstadd_back(&lst, &node);
+    return lst == &node && node.next == NULL;
 }
 
-void test_ft_isprint(void) {
-    print_header("ft_isprint");
-    safe_test("Printable characters", test_ft_isprint_printable);
-    safe_test("Non-printable", test_ft_isprint_non_printable);
+int test_ft_lstadd_back_basic(void) {
+    t_list nodes[3];
+    t_list node = { "new", NULL };
+    t_list *lst = test_stack_list(nodes, 3);
+    ft_lstadd_back(&lst, &node);
+    return lst == &nodes[0] && nodes[2].next == &node && node.next == NULL;
 }
 
-void test_ft_toupper(void) {
-    print_header("ft_toupper");
-    safe_test("Lowercase to uppercase", test_ft_toupper_lower);
-    safe_test("Already uppercase", test_ft_toupper_upper);
+/* Test functions for ft_lstsize */
+int test_ft_lstsize_basic(void) {
+    t_list nodes[5];
+    return ft_lstsize(test_stack_list(nodes, 5)) == 5;
 }
 
-void test_ft_tolower(void) {
-    print_header("ft_tolower");
-    safe_test("Uppercase to lowercase", test_ft_tolower_upper);
-    safe_test("Already lowercase", test_ft_tolower_lower);
+int test_ft_lstsize_empty(void) {
+    return ft_lstsize(NULL) == 0;
 }
 
-void test_ft_calloc(void) {
-    print_header("ft_calloc");
-    safe_test("Basic allocation", test_ft_calloc_basic);
-    safe_test("Zero allocation", test_ft_calloc_zero);
+/* Test functions for ft_lstlast */
+int test_ft_lstlast_basic(void) {
+    t_list nodes[4];
+    return ft_lstlast(test_stack_list(nodes, 4)) == &nodes[3];
 }
 
-void test_ft_substr(void) {
-    print_header("ft_substr");
-    safe_test("Basic substring", test_ft_substr_basic);
-    safe_test("Out of bounds", test_ft_substr_out_of_bounds);
-    safe_test("NULL string", test_ft_substr_null);
+int test_ft_lstlast_empty(void) {
+    return ft_lstlast(NULL) == NULL;
 }
 
-void test_ft_strjoin(void) {
-    print_header("ft_strjoin");
-    safe_test("Basic join", test_ft_strjoin_basic);
-    safe_test("Empty string", test_ft_strjoin_empty);
-    safe_test("NULL pointer", test_ft_strjoin_null);
+/* Test functions for ft_lstdelone: del runs once, the next node is kept */
+int test_ft_lstdelone_basic(void) {
+    t_list next = { "next", NULL };
+    t_list *node = ft_lstnew(strdup("content"));
+    if (!node) return 0;
+    node->next = &next;
+    g_del_calls = 0;
+    ft_lstdelone(node, test_del_free);
+    return g_del_calls == 1 && next.next == NULL && strcmp(next.content, "next") == 0;
 }
 
-void test_ft_strtrim(void) {
-    print_header("ft_strtrim");
-    safe_test("Basic trim", test_ft_strtrim_basic);
-    safe_test("No trimming needed", test_ft_strtrim_no_trim);
-    safe_test("NULL pointer", test_ft_strtrim_null);
+/* Test functions for ft_lstclear */
+int test_ft_lstclear_basic(void) {
+    t_list *lst = NULL;
+    for (int i = 0; i < 3; i++) {
+        t_list *node = ft_lstnew(strdup("content"));
+        if (!node) return 0;
+        node->next = lst;
+        lst = node;
+    }
+    g_del_calls = 0;
+    ft_lstclear(&lst, test_del_free);
+    return lst == NULL && g_del_calls == 3;
+}
+
+/* A recursive ft_lstclear runs out of stack long before a million nodes */
+int test_ft_lstclear_long(void) {
+    t_list *lst = NULL;
+    for (int i = 0; i < 1000000; i++) {
+        t_list *node = malloc(sizeof(*node));
+        if (!node) return 0;
+        node->content = NULL;
+        node->next = lst;
+        lst = node;
+    }
+    g_del_calls = 0;
+    ft_lstclear(&lst, test_del_count);
+    return lst == NULL && g_del_calls == 1000000;
 }
 
-void test_ft_split(void) {
-    print_header("ft_split");
-    safe_test("Basic split", test_ft_split_basic);
-    safe_test("Empty string", test_ft_split_empty);
-    safe_test("NULL pointer", test_ft_split_null);
+/* Test functions for ft_lstiter */
+static char g_iter_seen[16];
+
+static void test_iter_record(void *content) {
+    strcat(g_iter_seen, content);
 }
 
-void test_ft_itoa(void) {
-    print_header("ft_itoa");
-    safe_test("Positive number", test_ft_itoa_positive);
-    safe_test("Negative number", test_ft_itoa_negative);
-    safe_test("Zero", test_ft_itoa_zero);
+int test_ft_lstiter_basic(void) {
+    t_list nodes[5];
+    g_iter_seen[0] = '\0';
+    ft_lstiter(test_stack_list(nodes, 5), test_iter_record);
+    return strcmp(g_iter_seen, "01234") == 0;
 }
 
-void test_ft_strmapi(void) {
-    print_header("ft_strmapi");
-    safe_test("Basic mapping", test_ft_strmapi_basic);
-    safe_test("NULL pointer", test_ft_strmapi_null);
+/* Test functions for ft_lstmap */
+static void *test_map_twice(void *content) {
+    char *s = content;
+    char *r = malloc(3);
+    if (r) {
+        r[0] = s[0];
+        r[1] = s[0];
+        r[2] = '\0';
+    }
+    return r;
+}
+
+int test_ft_lstmap_basic(void) {
+    t_list nodes[3];
+    t_list *lst = test_stack_list(nodes, 3);
+    t_list *map = ft_lstmap(lst, test_map_twice, free);
+    if (!map) return 0;
+    int success = (ft_lstsize(map) == 3 && strcmp(map->content, "00") == 0
+                   && strcmp(map->next->content, "11") == 0
+                   && strcmp(map->next->next->content, "22") == 0
+                   && strcmp(nodes[1].content, "1") == 0);
+    ft_lstclear(&map, free);
+    return success;
 }
 
-void test_ft_striteri(void) {
-    print_header("ft_striteri");
-    safe_test("Basic iteration", test_ft_striteri_basic);
-    safe_test("NULL pointer", test_ft_striteri_null);
+int test_ft_lstmap_empty(void) {
+    return ft_lstmap(NULL, test_map_twice, free) == NULL;
+}
+#endif
+
+/* Every test, in run order; tests of a group stay together */
+static const t_test_entry g_registry[] = {
+    REGISTER_TEST("ft_strlen", "Basic string length", test_ft_strlen_basic),
+    REGISTER_TEST("ft_strlen", "Empty string", test_ft_strlen_empty),
+    REGISTER_TEST("ft_strlen", "NULL pointer", test_ft_strlen_null),
+    REGISTER_TEST("ft_strlen", "Long string (999 chars)", test_ft_strlen_long),
+    REGISTER_TEST("ft_strlen", "No read past the NUL (guard page)", test_ft_strlen_guarded),
+
+    REGISTER_TEST("ft_strchr", "Character found", test_ft_strchr_found),
+    REGISTER_TEST("ft_strchr", "Character not found", test_ft_strchr_not_found),
+    REGISTER_TEST("ft_strchr", "Null terminator search", test_ft_strchr_null_terminator),
+    REGISTER_TEST("ft_strchr", "NULL string", test_ft_strchr_null_string),
+
+    REGISTER_TEST("ft_strdup", "Basic duplication", test_ft_strdup_basic),
+    REGISTER_TEST("ft_strdup", "Empty string duplication", test_ft_strdup_empty),
+    REGISTER_TEST("ft_strdup", "NULL pointer duplication", test_ft_strdup_null),
+
+    REGISTER_TEST("ft_memset", "Basic memset", test_ft_memset_basic),
+    REGISTER_TEST("ft_memset", "Zero length", test_ft_memset_zero_length),
+    REGISTER_TEST("ft_memset", "NULL pointer", test_ft_memset_null),
+
+    REGISTER_TEST("ft_bzero", "Basic bzero", test_ft_bzero_basic),
+    REGISTER_TEST("ft_bzero", "Zero length", test_ft_bzero_zero_length),
+    REGISTER_TEST("ft_bzero", "NULL pointer", test_ft_bzero_null),
+
+    REGISTER_TEST("ft_memcpy", "Basic memcpy", test_ft_memcpy_basic),
+    REGISTER_TEST("ft_memcpy", "Zero length", test_ft_memcpy_zero_length),
+    REGISTER_TEST("ft_memcpy", "NULL pointer", test_ft_memcpy_null),
+
+    REGISTER_TEST("ft_memmove", "Basic memmove", test_ft_memmove_basic),
+    REGISTER_TEST("ft_memmove", "Overlapping memory", test_ft_memmove_overlap),
+    REGISTER_TEST("ft_memmove", "NULL pointer", test_ft_memmove_null),
+    REGISTER_TEST("ft_memmove", "Both directions at a guard page", test_ft_memmove_guarded),
+
+    REGISTER_TEST("ft_memchr", "Character found", test_ft_memchr_found),
+    REGISTER_TEST("ft_memchr", "Character not found", test_ft_memchr_not_found),
+    REGISTER_TEST("ft_memchr", "NULL pointer", test_ft_memchr_null),
+    REGISTER_TEST("ft_memchr", "No read past n (guard page)", test_ft_memchr_guarded),
+
+    REGISTER_TEST("ft_memcmp", "Equal memory", test_ft_memcmp_equal),
+    REGISTER_TEST("ft_memcmp", "Different memory", test_ft_memcmp_different),
+    REGISTER_TEST("ft_memcmp", "Zero length", test_ft_memcmp_zero_length),
+    REGISTER_TEST("ft_memcmp", "NULL pointer", test_ft_memcmp_null),
+    REGISTER_TEST("ft_memcmp", "No read past n (guard pages)", test_ft_memcmp_guarded),
+
+    REGISTER_TEST("ft_strlcpy", "Basic copy", test_ft_strlcpy_basic),
+    REGISTER_TEST("ft_strlcpy", "Truncation", test_ft_strlcpy_truncate),
+    REGISTER_TEST("ft_strlcpy", "NULL destination", test_ft_strlcpy_null_dst),
+    REGISTER_TEST("ft_strlcpy", "No access past dst or src (guard pages)", test_ft_strlcpy_guarded),
+
+    REGISTER_TEST("ft_strlcat", "Basic concatenation", test_ft_strlcat_basic),
+    REGISTER_TEST("ft_strlcat", "Truncation", test_ft_strlcat_truncate),
+    REGISTER_TEST("ft_strlcat", "NULL pointer", test_ft_strlcat_null),
+    REGISTER_TEST("ft_strlcat", "No access past dst or src (guard pages)", test_ft_strlcat_guarded),
+
+    REGISTER_TEST("ft_strrchr", "Character found", test_ft_strrchr_found),
+    REGISTER_TEST("ft_strrchr", "Character not found", test_ft_strrchr_not_found),
+    REGISTER_TEST("ft_strrchr", "NULL string", test_ft_strrchr_null),
+
+    REGISTER_TEST("ft_strncmp", "Equal strings", test_ft_strncmp_equal),
+    REGISTER_TEST("ft_strncmp", "Different strings", test_ft_strncmp_different),
+    REGISTER_TEST("ft_strncmp", "Partial comparison", test_ft_strncmp_partial),
+    REGISTER_TEST("ft_strncmp", "NULL pointer", test_ft_strncmp_null),
+
+    REGISTER_TEST("ft_strnstr", "Substring found", test_ft_strnstr_found),
+    REGISTER_TEST("ft_strnstr", "Substring not found", test_ft_strnstr_not_found),
+    REGISTER_TEST("ft_strnstr", "Limited by length", test_ft_strnstr_partial_limit),
+    REGISTER_TEST("ft_strnstr", "NULL pointer", test_ft_strnstr_null),
+    REGISTER_TEST("ft_strnstr", "No read past len (guard page)", test_ft_strnstr_guarded),
+
+    REGISTER_TEST("ft_atoi", "Positive number", test_ft_atoi_positive),
+    REGISTER_TEST("ft_atoi", "Negative number", test_ft_atoi_negative),
+    REGISTER_TEST("ft_atoi", "With whitespace", test_ft_atoi_whitespace),
+    REGISTER_TEST("ft_atoi", "Mixed characters", test_ft_atoi_mixed),
+    REGISTER_TEST("ft_atoi", "NULL pointer", test_ft_atoi_null),
+
+    REGISTER_TEST("ft_is* and ft_to* (ctype)", "All 257 inputs (EOF, 0..255) against the C locale", test_ft_ctype_table),
+
+    REGISTER_TEST("ft_calloc", "Basic allocation", test_ft_calloc_basic),
+    REGISTER_TEST("ft_calloc", "Zero allocation", test_ft_calloc_zero),
+
+    REGISTER_TEST("ft_substr", "Basic substring", test_ft_substr_basic),
+    REGISTER_TEST("ft_substr", "Out of bounds", test_ft_substr_out_of_bounds),
+    REGISTER_TEST("ft_substr", "NULL string", test_ft_substr_null),
+
+    REGISTER_TEST("ft_strjoin", "Basic join", test_ft_strjoin_basic),
+    REGISTER_TEST("ft_strjoin", "Empty string", test_ft_strjoin_empty),
+    REGISTER_TEST("ft_strjoin", "NULL pointer", test_ft_strjoin_null),
+
+    REGISTER_TEST("ft_strtrim", "Basic trim", test_ft_strtrim_basic),
+    REGISTER_TEST("ft_strtrim", "No trimming needed", test_ft_strtrim_no_trim),
+    REGISTER_TEST("ft_strtrim", "NULL pointer", test_ft_strtrim_null),
+
+    REGISTER_TEST("ft_split", "Basic split", test_ft_split_basic),
+    REGISTER_TEST("ft_split", "Empty string", test_ft_split_empty),
+    REGISTER_TEST("ft_split", "NULL pointer", test_ft_split_null),
+
+    REGISTER_TEST("ft_itoa", "Positive number", test_ft_itoa_positive),
+    REGISTER_TEST("ft_itoa", "Negative number", test_ft_itoa_negative),
+    REGISTER_TEST("ft_itoa", "Zero", test_ft_itoa_zero),
+
+    REGISTER_TEST("ft_strmapi", "Basic mapping", test_ft_strmapi_basic),
+    REGISTER_TEST("ft_strmapi", "NULL pointer", test_ft_strmapi_null),
+
+    REGISTER_TEST("ft_striteri", "Basic iteration", test_ft_striteri_basic),
+    REGISTER_TEST("ft_striteri", "NULL pointer", test_ft_striteri_null),
+
+    REGISTER_TEST("ft_putchar_fd", "Writes the byte", test_ft_putchar_fd_basic),
+    REGISTER_TEST("ft_putchar_fd", "Byte above 127", test_ft_putchar_fd_high),
+    REGISTER_TEST("ft_putchar_fd", "One write() call", test_ft_putchar_fd_writes),
+
+    REGISTER_TEST("ft_putstr_fd", "Exact bytes", test_ft_putstr_fd_basic),
+    REGISTER_TEST("ft_putstr_fd", "Empty string", test_ft_putstr_fd_empty),
+    REGISTER_TEST("ft_putstr_fd", "NULL string", test_ft_putstr_fd_null),
+    REGISTER_TEST("ft_putstr_fd", "2 MiB string", test_ft_putstr_fd_long),
+    REGISTER_TEST("ft_putstr_fd", "One write() call (not per byte)", test_ft_putstr_fd_writes),
+    REGISTER_TEST("ft_putstr_fd", "2 MiB in at most 32 write() calls", test_ft_putstr_fd_long_writes),
+
+    REGISTER_TEST("ft_putendl_fd", "String with newline", test_ft_putendl_fd_basic),
+    REGISTER_TEST("ft_putendl_fd", "Empty string", test_ft_putendl_fd_empty),
+    REGISTER_TEST("ft_putendl_fd", "At most two write() calls", test_ft_putendl_fd_writes),
+
+    REGISTER_TEST("ft_putnbr_fd", "Positive number", test_ft_putnbr_fd_basic),
+    REGISTER_TEST("ft_putnbr_fd", "Zero", test_ft_putnbr_fd_zero),
+    REGISTER_TEST("ft_putnbr_fd", "Negative number", test_ft_putnbr_fd_negative),
+    REGISTER_TEST("ft_putnbr_fd", "INT_MAX", test_ft_putnbr_fd_int_max),
+    REGISTER_TEST("ft_putnbr_fd", "INT_MIN", test_ft_putnbr_fd_int_min),
+    REGISTER_TEST("ft_putnbr_fd", "INT_MIN in at most two write() calls (not per digit)", test_ft_putnbr_fd_writes),
+#ifdef BONUS
+
+    REGISTER_TEST("ft_lstnew", "Basic node", test_ft_lstnew_basic),
+    REGISTER_TEST("ft_lstnew", "NULL content", test_ft_lstnew_null_content),
+
+    REGISTER_TEST("ft_lstadd_front", "Onto an empty list", test_ft_lstadd_front_empty),
+    REGISTER_TEST("ft_lstadd_front", "Onto a list", test_ft_lstadd_front_basic),
+
+    REGISTER_TEST("ft_lstadd_back", "Onto an empty list", test_ft_lstadd_back_empty),
+    REGISTER_TEST("ft_lstadd_back", "Onto a list", test_ft_lstadd_back_basic),
+
+    REGISTER_TEST("ft_lstsize", "Five nodes", test_ft_lstsize_basic),
+    REGISTER_TEST("ft_lstsize", "Empty list", test_ft_lstsize_empty),
+
+    REGISTER_TEST("ft_lstlast", "Last of four nodes", test_ft_lstlast_basic),
+    REGISTER_TEST("ft_lstlast", "Empty list", test_ft_lstlast_empty),
+
+    REGISTER_TEST_USES("ft_lstdelone", "One del call, next node kept", test_ft_lstdelone_basic, "ft_lstnew"),
+
+    REGISTER_TEST_USES("ft_lstclear", "Every content deleted", test_ft_lstclear_basic, "ft_lstnew"),
+    REGISTER_TEST("ft_lstclear", "1M nodes (no recursion)", test_ft_lstclear_long),
+
+    REGISTER_TEST("ft_lstiter", "Applied in order", test_ft_lstiter_basic),
+
+    REGISTER_TEST_USES("ft_lstmap", "Basic mapping", test_ft_lstmap_basic, "ft_lstsize ft_lstclear"),
+    REGISTER_TEST("ft_lstmap", "Empty list", test_ft_lstmap_empty),
+#endif
+};
+#define NTESTS ((int)(sizeof(g_registry) / sizeof(g_registry[0])))
+
+/* Print command-line usage */
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-j N] [--pool | --inproc] [--timeout=[FUNC:]MS] [--global-timeout=MS]\n"
+                    "       %*s [--format=text|json|tap|junit] [--output=FILE]\n"
+                    "       %*s [--list] [--group=GLOB] [--test=GLOB] [GLOB...]\n"
+                    "       %*s [--shard=I/N [--durations=FILE]] [--lib=FILE.so...]\n"
+                    "       %*s [--cache[=FILE] | --no-cache] [--perf]\n", prog,
+            (int)strlen(prog), "", (int)strlen(prog), "", (int)strlen(prog), "",
+            (int)strlen(prog), "");
+    fprintf(stderr, "       %s --merge FILE...\n", prog);
+    fprintf(stderr, "       %s --bench [--bench-max=SIZE] [--bench-only=FUNC] [--csv=FILE] [--perf]\n", prog);
+    fprintf(stderr, "       %s --bench-matrix FILE.csv...\n", prog);
+    fprintf(stderr, "       %s --vector [--bench-max=SIZE] [--bench-only=FUNC]\n", prog);
+    fprintf(stderr, "       %s --complexity [--bench-max=SIZE] [--bench-only=FUNC]\n", prog);
+    fprintf(stderr, "       %s --io [--lib=FILE.so] [--bench-only=FUNC]\n", prog);
+    fprintf(stderr, "       %s --stress [--stress-max=SIZE] [--bench-only=FUNC]\n", prog);
+#ifdef BONUS
+    fprintf(stderr, "       %s --lst-bench [--bench-only=FUNC]\n", prog);
+#endif
+    fprintf(stderr, "       %s --failinject [-j N] [--bench-only=FUNC]\n", prog);
+    fprintf(stderr, "       %s --fuzz [-j N] [--fuzz-iters=N] [--fuzz-time=MS] [--seed=N] [--bench-only=FUNC]\n", prog);
+    fprintf(stderr, "  -j N, --jobs=N   run up to N tests in parallel (default: %d)\n",
+            default_jobs());
+    fprintf(stderr, "  --pool           reuse pre-forked workers instead of one fork per test\n");
+    fprintf(stderr, "  --inproc         run tests inside the runner, forking only for crashes\n");
+    fprintf(stderr, "  --timeout=MS     per-test time limit, 0 for none (default: %d)\n",
+            DEFAULT_TIMEOUT_MS);
+    fprintf(stderr, "  --timeout=F:MS   per-test time limit for function F, e.g. ft_split:200\n");
+    fprintf(stderr, "  --global-timeout=MS  time limit for the whole run\n");
+    fprintf(stderr, "  --list           print the selected tests as group/name and exit\n");
+    fprintf(stderr, "  --group=GLOB     only run functions matching GLOB, e.g. 'ft_str*'\n");
+    fprintf(stderr, "  --test=GLOB      only run tests whose name matches GLOB, e.g. 'NULL*'\n");
+    fprintf(stderr, "  GLOB             only run tests whose group or group/name matches\n");
+    fprintf(stderr, "  --shard=I/N      run only the I-th of N balanced parts of the selected tests\n");
+    fprintf(stderr, "  --durations=FILE balance shards with the timings of a --format=json report\n");
+    fprintf(stderr, "  --merge FILE...  print the summary of several --format=json reports\n");
+    fprintf(stderr, "  --lib=FILE.so    test a shared libft instead of the linked one; given more\n"
+                    "                   than once, test each and print one row per library\n");
+    fprintf(stderr, "  --cache[=FILE]   reuse results of tests whose libft objects are unchanged\n"
+                    "                   (default file: %s)\n", DEFAULT_CACHE_FILE);
+    fprintf(stderr, "  --no-cache       run every test, even after --cache\n");
+    fprintf(stderr, "  --perf           count cycles, instructions, branch and cache misses per\n"
+                    "                   test and benchmark (times only without perf_event_open)\n");
+    fprintf(stderr, "  --format=FMT     results as text (default), json, tap or junit\n");
+    fprintf(stderr, "  --output=FILE    write --format results to FILE, keeping text on stdout\n");
+    fprintf(stderr, "  --bench          time ft_* mem/str functions against libc instead of testing\n");
+    fprintf(stderr, "  --bench-matrix FILE.csv...  compare the --csv files of several libft builds\n");
+    fprintf(stderr, "  --vector         classify mem* and ft_strlen as byte-wise, word-at-a-time or SIMD\n");
+    fprintf(stderr, "  --complexity     flag functions whose time grows faster than their input\n");
+    fprintf(stderr, "  --io             count the write() calls of the put*_fd functions, bytes per call\n");
+    fprintf(stderr, "  --stress         check mem/str functions against libc on 1 MiB+ buffers\n");
+    fprintf(stderr, "  --stress-max=SIZE largest stress buffer (default: 1G)\n");
+#ifdef BONUS
+    fprintf(stderr, "  --lst-bench      time the t_list functions on 10^6 .. 10^7 nodes\n");
+#endif
+    fprintf(stderr, "  --failinject     fail each malloc of the allocating functions in turn\n");
+    fprintf(stderr, "  --fuzz           compare ft_* functions with libc/BSD on random inputs\n");
+    fprintf(stderr, "  --fuzz-iters=N   inputs per function (default: %d)\n", FUZZ_DEFAULT_ITERS);
+    fprintf(stderr, "  --fuzz-time=MS   time budget for the whole fuzz run\n");
+    fprintf(stderr, "  --seed=N         fuzzer seed (default: random, printed)\n");
+    fprintf(stderr, "  --bench-max=SIZE largest benchmark/complexity size, e.g. 1M (default: 64M)\n");
+    fprintf(stderr, "  --bench-only=F   benchmark or check a single function, e.g. ft_memcpy\n");
+    fprintf(stderr, "  --csv=FILE       also write benchmark results as CSV\n");
+}
+
+/* Parse a strictly positive integer option value */
+static int parse_count(const char *s, int *out) {
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (*s == '\0' || *end != '\0' || v < 1 || v > 4096)
+        return 0;
+    *out = (int)v;
+    return 1;
 }
 
-void test_ft_putchar_fd(void) {
-    print_header("ft_putchar_fd");
-    printf("Expected output: A");
-    safe_test("Basic character output", test_ft_putchar_fd_basic);
+/* Parse a millisecond count; 0 means no limit */
+static int parse_ms(const char *s, long *out) {
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (*s == '\0' || *end != '\0' || v < 0)
+        return 0;
+    *out = v;
+    return 1;
 }
 
-void test_ft_putstr_fd(void) {
-    print_header("ft_putstr_fd");
-    printf("Expected output: Hello\\n");
-    safe_test("Basic string output", test_ft_putstr_fd_basic);
-    safe_test("NULL string", test_ft_putstr_fd_null);
+/* Parse --timeout=MS or --timeout=FUNC:MS */
+static int parse_timeout(const char *s, t_run_config *cfg) {
+    const char *colon = strrchr(s, ':');
+    if (!colon)
+        return parse_ms(s, &cfg->timeout_ms);
+    if (colon == s || cfg->noverrides >= MAX_TIMEOUT_OVERRIDES)
+        return 0;
+    t_timeout_override *o = &cfg->overrides[cfg->noverrides];
+    char *name = strndup(s, colon - s);
+    if (!name || !parse_ms(colon + 1, &o->ms)) {
+        free(name);
+        return 0;
+    }
+    o->function = name;
+    cfg->noverrides++;
+    return 1;
 }
 
-void test_ft_putendl_fd(void) {
-    print_header("ft_putendl_fd");
-    printf("Expected output: Hello\\n");
-    safe_test("String with newline", test_ft_putendl_fd_basic);
+/* Parse an unsigned decimal number */
+static int parse_ulong(const char *s, unsigned long *out) {
+    char *end;
+    if (*s == '\0' || *s == '-')
+        return 0;
+    unsigned long v = strtoul(s, &end, 10);
+    if (*end != '\0')
+        return 0;
+    *out = v;
+    return 1;
 }
 
-void test_ft_putnbr_fd(void) {
-    print_header("ft_putnbr_fd");
-    printf("Expected output: 42\\n");
-    safe_test("Basic number output", test_ft_putnbr_fd_basic);
-    safe_test("NULL pointer", test_ft_memset_null);
+/* Parse a byte count with an optional K, M or G suffix */
+static int parse_size(const char *s, size_t *out) {
+    char *end;
+    unsigned long long v = strtoull(s, &end, 10);
+    if (end == s || *s == '-')
+        return 0;
+    if (*end == 'K' || *end == 'k')
+        v <<= 10, end++;
+    else if (*end == 'M' || *end == 'm')
+        v <<= 20, end++;
+    else if (*end == 'G' || *end == 'g')
+        v <<= 30, end++;
+    if (*end == 'i' && end[1] == 'B')
+        end += 2;
+    else if (*end == 'B')
+        end++;
+    if (*end != '\0' || v == 0)
+        return 0;
+    *out = (size_t)v;
+    return 1;
 }
 
-/* Print final statistics */
-void print_stats(void) {
-    printf(BOLD CYAN "\n=== TEST SUMMARY ===" RESET "\n");
-    printf("Total tests: %d\n", g_stats.total);
-    printf(GREEN "Passed: %d" RESET "\n", g_stats.passed);
-    printf(RED "Failed: %d" RESET "\n", g_stats.failed);
-    printf(MAGENTA "Segfaults: %d" RESET "\n", g_stats.segfaults);
-    
-    double success_rate = g_stats.total > 0 ? 
-        (double)g_stats.passed / g_stats.total * 100 : 0;
-    
-    if (success_rate >= 90) {
-        printf(GREEN BOLD "Success rate: %.1f%%" RESET "\n", success_rate);
-    } else if (success_rate >= 70) {
-        printf(YELLOW BOLD "Success rate: %.1f%%" RESET "\n", success_rate);
-    } else {
-        printf(RED BOLD "Success rate: %.1f%%" RESET "\n", success_rate);
+int main(int argc, char **argv) {
+    t_run_config cfg = { .jobs = default_jobs(), .mode = MODE_FORK,
+                         .timeout_ms = DEFAULT_TIMEOUT_MS };
+    t_bench_config bench = { BENCH_MAX_SIZE, NULL, NULL, STRESS_MAX_SIZE, 0 };
+    int bench_mode = 0;
+    int complexity_mode = 0;
+    int vector_mode = 0;
+    int stress_mode = 0;
+    int io_mode = 0;
+    int lst_mode = 0;
+    int failinject_mode = 0;
+    int fuzz_mode = 0;
+    int fuzz_iters_set = 0;
+    int list_mode = 0;
+    const char **libs = calloc(argc, sizeof(*libs));
+    int nlibs = 0;
+    t_test_filter filter = { .ngroups = 0 };
+    t_fuzz_config fuzz = { FUZZ_DEFAULT_ITERS, 0, (unsigned long)time(NULL) ^ (unsigned long)getpid(),
+                           NULL, 0 };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = NULL;
+        if (strcmp(arg, "--pool") == 0) {
+            cfg.mode = MODE_POOL;
+            continue;
+        }
+        if (strcmp(arg, "--inproc") == 0) {
+            cfg.mode = MODE_INPROC;
+            continue;
+        }
+        if (strncmp(arg, "--timeout=", 10) == 0) {
+            if (!parse_timeout(arg + 10, &cfg)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--format=", 9) == 0) {
+            if (!parse_format(arg + 9, &cfg.format)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--output=", 9) == 0) {
+            cfg.output_path = arg + 9;
+            continue;
+        }
+        if (strcmp(arg, "--list") == 0) {
+            list_mode = 1;
+            continue;
+        }
+        if (strncmp(arg, "--group=", 8) == 0) {
+            if (!add_filter(filter.groups, &filter.ngroups, arg + 8)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--test=", 7) == 0) {
+            if (!add_filter(filter.names, &filter.nnames, arg + 7)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--shard=", 8) == 0) {
+            if (!parse_shard(arg + 8, &filter)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--durations=", 12) == 0) {
+            filter.durations_path = arg + 12;
+            continue;
+        }
+        if (strcmp(arg, "--cache") == 0 || strncmp(arg, "--cache=", 8) == 0) {
+            cfg.cache_path = arg[7] == '=' ? arg + 8 : DEFAULT_CACHE_FILE;
+            continue;
+        }
+        if (strcmp(arg, "--perf") == 0) {
+            cfg.perf = 1;
+            bench.perf = 1;
+            continue;
+        }
+        if (strcmp(arg, "--no-cache") == 0) {
+            cfg.cache_path = NULL;
+            continue;
+        }
+        if (strncmp(arg, "--lib=", 6) == 0) {
+            if (!libs) {
+                perror("libft_test");
+                return 2;
+            }
+            libs[nlibs++] = arg + 6;
+            continue;
+        }
+        /* Everything after --merge is a report file */
+        if (strcmp(arg, "--merge") == 0) {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                return 2;
+            }
+            return merge_reports(argv + i + 1, argc - i - 1);
+        }
+        /* and after --bench-matrix a --csv file of --bench */
+        if (strcmp(arg, "--bench-matrix") == 0) {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                return 2;
+            }
+            return run_bench_matrix(argv + i + 1, argc - i - 1);
+        }
+        if (arg[0] != '-') {
+            if (!add_filter(filter.paths, &filter.npaths, arg)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--global-timeout=", 17) == 0) {
+            if (!parse_ms(arg + 17, &cfg.global_timeout_ms)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strcmp(arg, "--bench") == 0) {
+            bench_mode = 1;
+            continue;
+        }
+        if (strcmp(arg, "--vector") == 0) {
+            vector_mode = 1;
+            continue;
+        }
+        if (strcmp(arg, "--complexity") == 0) {
+            complexity_mode = 1;
+            continue;
+        }
+        if (strcmp(arg, "--io") == 0) {
+            io_mode = 1;
+            continue;
+        }
+        if (strcmp(arg, "--stress") == 0) {
+            stress_mode = 1;
+            continue;
+        }
+#ifdef BONUS
+        if (strcmp(arg, "--lst-bench") == 0) {
+            lst_mode = 1;
+            continue;
+        }
+#endif
+        if (strcmp(arg, "--failinject") == 0) {
+            failinject_mode = 1;
+            continue;
+        }
+        if (strcmp(arg, "--fuzz") == 0) {
+            fuzz_mode = 1;
+            continue;
+        }
+        if (strncmp(arg, "--fuzz-iters=", 13) == 0) {
+            unsigned long iters;
+            if (!parse_ulong(arg + 13, &iters) || iters == 0 || iters > LONG_MAX) {
+                usage(argv[0]);
+                return 2;
+            }
+            fuzz.iters = (long)iters;
+            fuzz_iters_set = 1;
+            continue;
+        }
+        if (strncmp(arg, "--fuzz-time=", 12) == 0) {
+            if (!parse_ms(arg + 12, &fuzz.time_ms)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--seed=", 7) == 0) {
+            if (!parse_ulong(arg + 7, &fuzz.seed)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--stress-max=", 13) == 0) {
+            if (!parse_size(arg + 13, &bench.stress_max)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--bench-max=", 12) == 0) {
+            if (!parse_size(arg + 12, &bench.max_size)) {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (strncmp(arg, "--bench-only=", 13) == 0) {
+            bench.only = arg + 13;
+            continue;
+        }
+        if (strncmp(arg, "--csv=", 6) == 0) {
+            bench.csv_path = arg + 6;
+            continue;
+        }
+        if (strcmp(arg, "-j") == 0 && i + 1 < argc)
+            value = argv[++i];
+        else if (strncmp(arg, "-j", 2) == 0 && arg[2] != '\0')
+            value = arg + 2;
+        else if (strncmp(arg, "--jobs=", 7) == 0)
+            value = arg + 7;
+        if (!value || !parse_count(value, &cfg.jobs)) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    /* The matrix is the only report of a multi-library run */
+    if (nlibs > 1 && (cfg.format != FORMAT_TEXT || cfg.output_path)) {
+        fprintf(stderr, "libft_test: --format and --output need a single --lib\n");
+        return 2;
     }
-    
-    if (g_stats.segfaults > 0) {
-        printf(RED "\n⚠️  Warning: %d segfault(s) detected! Check your implementations.\n" RESET, 
-               g_stats.segfaults);
+    if (nlibs == 1 && !load_libft(libs[0]))
+        return 2;
+    /* A sanitizer report ends the process it happens in, so keep tests in children */
+    if (sanitizer_name() && cfg.mode == MODE_INPROC) {
+        fprintf(stderr, "libft_test: --inproc is not available in the %s build, forking instead\n",
+                sanitizer_name());
+        cfg.mode = MODE_FORK;
     }
-}
+    /* The cache is keyed by the linked libft.a */
+    if (nlibs > 0)
+        cfg.cache_path = NULL;
+
+    if (list_mode)
+        return list_tests(g_registry, NTESTS, &filter) > 0 ? 0 : 1;
+
+    /* A machine format on stdout must not be mixed with the text report */
+    int text = cfg.format == FORMAT_TEXT || cfg.output_path;
+    if (text || bench_mode || vector_mode || complexity_mode || io_mode || stress_mode || lst_mode
+        || failinject_mode || fuzz_mode)
+        printf(BOLD BLUE "🧪 LIBFT TESTER - Advanced Edition 🧪" RESET "\n"); 
+    if (bench_mode)
+        return run_benchmarks(&bench);
+    if (vector_mode)
+        return run_vector_report(&bench);
+    if (complexity_mode)
+        return run_complexity(&bench);
+    if (io_mode)
+        return run_io_profile(&bench);
+    if (stress_mode)
+        return run_stress(&bench);
+#ifdef BONUS
+    if (lst_mode)
+        return run_lst_bench(&bench);
+#endif
+    if (failinject_mode)
+        return run_failinject(&cfg, bench.only);
+    if (fuzz_mode) {
+        /* A time budget alone means as many inputs as fit in it */
+        if (fuzz.time_ms > 0 && !fuzz_iters_set)
+            fuzz.iters = 0;
+        fuzz.only = bench.only;
+        fuzz.jobs = cfg.jobs;
+        return run_fuzz(&fuzz);
+    }
+    /* An empty shard is fine: there may be more shards than tests */
+    if (register_tests(g_registry, NTESTS, &filter) == 0
+        && !filter.nshards) {
+        fprintf(stderr, "libft_test: no test matches the given filters\n");
+        return 2;
+    }
+    if (nlibs > 1) {
+        printf("Testing %d libraries, up to %d at a time\n", nlibs, cfg.jobs);
+        return run_libs(libs, nlibs, &cfg);
+    }
+    if (text)
+        printf("Testing libft functions with edge cases and segfault detection\n");
+    if (text && nlibs == 1)
+        printf("Library: %s\n", libs[0]);
 
-int main(void) {
-    printf(BOLD BLUE "🧪 LIBFT TESTER - Advanced Edition 🧪" RESET "\n"); 
-    printf("Testing libft functions with edge cases and segfault detection\n");
-    /* Call all test groups */
-    test_ft_strlen();
-    test_ft_strchr();
-    test_ft_strdup();
-    test_ft_memset();
-    test_ft_bzero();
-    test_ft_memcpy();
-    test_ft_memmove();
-    test_ft_memchr();
-    test_ft_memcmp();
-    test_ft_strlcpy();
-    test_ft_strlcat();
-    test_ft_strrchr();
-    test_ft_strncmp();
-    test_ft_strnstr();
-    test_ft_atoi();
-    test_ft_isalpha();
-    test_ft_isdigit();
-    test_ft_isalnum();
-    test_ft_isascii();
-    test_ft_isprint();
-    test_ft_toupper();
-    test_ft_tolower();
-    test_ft_calloc();
-    test_ft_substr();
-    test_ft_strjoin();
-    test_ft_strtrim();
-    test_ft_split();
-    test_ft_itoa();
-    test_ft_strmapi();
-    test_ft_striteri();
-    test_ft_putchar_fd();
-    test_ft_putstr_fd();
-    test_ft_putendl_fd();
-    test_ft_putnbr_fd();
+    /* Run them, up to `cfg.jobs` at a time */
+    run_tests(&cfg);
 
     /* Print final statistics */
-    printf(BOLD CYAN "\n=== TEST SUMMARY ===" RESET "\n");
-    printf("Total:   %d\n", g_stats.total);
-    printf(GREEN "Passed:  %d\n" RESET, g_stats.passed);
-    printf(RED "Failed:  %d\n" RESET, g_stats.failed);
-    printf(RED "Segfaults: %d\n" RESET, g_stats.segfaults);
+    if (text)
+        print_stats();
 
-    return (g_stats.failed == 0 && g_stats.segfaults == 0) ? 0 : 1;
+    return (g_stats.failed == 0 && g_stats.segfaults == 0 && g_stats.timeouts == 0) ? 0 : 1;
 }
 
 
 /* 
  * Compilation instructions:
- * gcc -Wall -Wextra -Werror main.c -L. -lft -o libft_test
+ * gcc -Wall -Wextra -Werror -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc,--wrap=write \
+ *     main.c runner.c registry.c alloc.c bench.c complexity.c stress.c failinject.c \
+ *     oracle.c fuzz.c report.c ftable.c cache.c perf.c guard.c capture.c io.c sanitize.c -L. -lft -lm -ldl -o libft_test
+ * (add -DBONUS lst.c for the t_list tests)
  * 
  * Or if you have individual .c files:
- * gcc -Wall -Wextra -Werror main.c ft_strlen.c ft_strchr.c ft_strdup.c ft_memset.c -o libft_test
+ * gcc -Wall -Wextra -Werror main.c runner.c ft_strlen.c ft_strchr.c ft_strdup.c ft_memset.c -o libft_test
  */
\ No newline at end of file
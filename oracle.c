@@ -0,0 +1,518 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include "tester.h"
+
+/*
+ * Oracles: each one runs an ft_* function and its libc (or BSD, or
+ * reference) equivalent on the same fuzz input and reports the first
+ * difference. Inputs are clamped so that both calls stay in bounds.
+ */
+
+#define FAIL(...) do { snprintf(why, len, __VA_ARGS__); return 0; } while (0)
+
+/* Large enough for any string built from both inputs */
+#define DST_CAP  (2 * FUZZ_MAX_LEN + 2)
+
+/* Largest calloc the oracle actually lets succeed and checks */
+#define CALLOC_CHECK_MAX  (1UL << 20)
+
+static size_t min_size(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+static int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+/* The input's buffers as NUL-terminated strings (embedded NULs cut them) */
+static void input_strings(const t_fuzz_input *in, char *a, char *b) {
+    memcpy(a, in->a, in->alen);
+    a[in->alen] = '\0';
+    memcpy(b, in->b, in->blen);
+    b[in->blen] = '\0';
+}
+
+static size_t first_diff(const void *x, const void *y, size_t n) {
+    const unsigned char *p = x;
+    const unsigned char *q = y;
+    size_t i = 0;
+    while (i < n && p[i] == q[i])
+        i++;
+    return i;
+}
+
+/* Offset of a returned pointer, or -1 for NULL */
+static long offset_of(const void *p, const void *base) {
+    return p ? (long)((const char *)p - (const char *)base) : -1;
+}
+
+/* BSD strlcpy(3): copy up to size - 1 bytes, always terminate */
+size_t ref_strlcpy(char *dst, const char *src, size_t size) {
+    size_t slen = strlen(src);
+    if (size > 0) {
+        size_t n = slen < size - 1 ? slen : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return slen;
+}
+
+/* BSD strlcat(3): append into a buffer of `size` bytes */
+size_t ref_strlcat(char *dst, const char *src, size_t size) {
+    size_t dlen = 0;
+    while (dlen < size && dst[dlen])
+        dlen++;
+    if (dlen == size)
+        return size + strlen(src);
+    return dlen + ref_strlcpy(dst + dlen, src, size - dlen);
+}
+
+/* BSD strnstr(3): first `needle` in the first `n` bytes of `hay` */
+char *ref_strnstr(const char *hay, const char *needle, size_t n) {
+    size_t nlen = strlen(needle);
+    if (nlen == 0)
+        return (char *)hay;
+    for (size_t i = 0; i < n && hay[i]; i++) {
+        if (nlen <= n - i && strncmp(hay + i, needle, nlen) == 0)
+            return (char *)hay + i;
+    }
+    return NULL;
+}
+
+/* --- mem* ---------------------------------------------------------------- */
+
+static int check_memset(const t_fuzz_input *in, char *why, size_t len) {
+    unsigned char x[FUZZ_MAX_LEN + 1];
+    unsigned char y[FUZZ_MAX_LEN + 1];
+    size_t n = min_size(in->n, in->alen);
+
+    memcpy(x, in->a, in->alen);
+    memcpy(y, in->a, in->alen);
+    void *r = ft_memset(x, in->c, n);
+    memset(y, in->c, n);
+    if (r != x)
+        FAIL("ft_memset(a, c, %zu) did not return a", n);
+    size_t i = first_diff(x, y, in->alen);
+    if (i < in->alen)
+        FAIL("ft_memset(a, %d, %zu): byte %zu is 0x%02x, memset gives 0x%02x",
+             in->c, n, i, x[i], y[i]);
+    return 1;
+}
+
+static int check_bzero(const t_fuzz_input *in, char *why, size_t len) {
+    unsigned char x[FUZZ_MAX_LEN + 1];
+    unsigned char y[FUZZ_MAX_LEN + 1];
+    size_t n = min_size(in->n, in->alen);
+
+    memcpy(x, in->a, in->alen);
+    memcpy(y, in->a, in->alen);
+    ft_bzero(x, n);
+    memset(y, 0, n);
+    size_t i = first_diff(x, y, in->alen);
+    if (i < in->alen)
+        FAIL("ft_bzero(a, %zu): byte %zu is 0x%02x, bzero gives 0x%02x", n, i, x[i], y[i]);
+    return 1;
+}
+
+static int check_memcpy(const t_fuzz_input *in, char *why, size_t len) {
+    unsigned char x[FUZZ_MAX_LEN + 1];
+    unsigned char y[FUZZ_MAX_LEN + 1];
+    size_t n = min_size(in->n, min_size(in->alen, in->blen));
+
+    memcpy(x, in->a, in->alen);
+    memcpy(y, in->a, in->alen);
+    void *r = ft_memcpy(x, in->b, n);
+    memcpy(y, in->b, n);
+    if (r != x)
+        FAIL("ft_memcpy(a, b, %zu) did not return a", n);
+    size_t i = first_diff(x, y, in->alen);
+    if (i < in->alen)
+        FAIL("ft_memcpy(a, b, %zu): byte %zu is 0x%02x, memcpy gives 0x%02x",
+             n, i, x[i], y[i]);
+    return 1;
+}
+
+/* Overlapping move inside a: from offset `off` to offset `c` */
+static int check_memmove(const t_fuzz_input *in, char *why, size_t len) {
+    unsigned char x[FUZZ_MAX_LEN + 1];
+    unsigned char y[FUZZ_MAX_LEN + 1];
+    size_t src = in->off % (in->alen + 1);
+    size_t dst = (size_t)(unsigned)in->c % (in->alen + 1);
+    size_t n = min_size(in->n, in->alen - (src > dst ? src : dst));
+
+    memcpy(x, in->a, in->alen);
+    memcpy(y, in->a, in->alen);
+    void *r = ft_memmove(x + dst, x + src, n);
+    memmove(y + dst, y + src, n);
+    if (r != x + dst)
+        FAIL("ft_memmove(a + %zu, a + %zu, %zu) did not return dst", dst, src, n);
+    size_t i = first_diff(x, y, in->alen);
+    if (i < in->alen)
+        FAIL("ft_memmove(a + %zu, a + %zu, %zu): byte %zu is 0x%02x, memmove gives 0x%02x",
+             dst, src, n, i, x[i], y[i]);
+    return 1;
+}
+
+/* n may exceed the buffer (up to SIZE_MAX) when the byte is known to be there */
+static int check_memchr(const t_fuzz_input *in, char *why, size_t len) {
+    size_t n = in->n;
+
+    if (!memchr(in->a, in->c, in->alen))
+        n = min_size(n, in->alen);
+    long got = offset_of(ft_memchr(in->a, in->c, n), in->a);
+    long want = offset_of(memchr(in->a, in->c, n), in->a);
+    if (got != want)
+        FAIL("ft_memchr(a, %d, %zu) returned offset %ld, memchr gives %ld", in->c, n, got, want);
+    return 1;
+}
+
+static int check_memcmp(const t_fuzz_input *in, char *why, size_t len) {
+    size_t n = min_size(in->n, min_size(in->alen, in->blen));
+    int got = ft_memcmp(in->a, in->b, n);
+    int want = memcmp(in->a, in->b, n);
+
+    if (sign(got) != sign(want))
+        FAIL("ft_memcmp(a, b, %zu) returned %d, memcmp gives %d", n, got, want);
+    return 1;
+}
+
+/* --- str* ---------------------------------------------------------------- */
+
+static int check_strlen(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+
+    input_strings(in, a, b);
+    size_t got = ft_strlen(a);
+    if (got != strlen(a))
+        FAIL("ft_strlen(a) returned %zu, strlen gives %zu", got, strlen(a));
+    return 1;
+}
+
+static int check_strchr(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+
+    input_strings(in, a, b);
+    long got = offset_of(ft_strchr(a, in->c), a);
+    long want = offset_of(strchr(a, in->c), a);
+    if (got != want)
+        FAIL("ft_strchr(a, %d) returned offset %ld, strchr gives %ld", in->c, got, want);
+    return 1;
+}
+
+static int check_strrchr(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+
+    input_strings(in, a, b);
+    long got = offset_of(ft_strrchr(a, in->c), a);
+    long want = offset_of(strrchr(a, in->c), a);
+    if (got != want)
+        FAIL("ft_strrchr(a, %d) returned offset %ld, strrchr gives %ld", in->c, got, want);
+    return 1;
+}
+
+static int check_strncmp(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+
+    input_strings(in, a, b);
+    int got = ft_strncmp(a, b, in->n);
+    int want = strncmp(a, b, in->n);
+    if (sign(got) != sign(want))
+        FAIL("ft_strncmp(a, b, %zu) returned %d, strncmp gives %d", in->n, got, want);
+    return 1;
+}
+
+static int check_strlcpy(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+    char x[DST_CAP];
+    char y[DST_CAP];
+    size_t size = min_size(in->n, DST_CAP);
+
+    input_strings(in, a, b);
+    memset(x, '#', DST_CAP);
+    memset(y, '#', DST_CAP);
+    size_t got = ft_strlcpy(x, b, size);
+    size_t want = ref_strlcpy(y, b, size);
+    if (got != want)
+        FAIL("ft_strlcpy(dst, b, %zu) returned %zu, BSD strlcpy gives %zu", size, got, want);
+    size_t i = first_diff(x, y, DST_CAP);
+    if (i < DST_CAP)
+        FAIL("ft_strlcpy(dst, b, %zu): dst[%zu] is 0x%02x, BSD strlcpy gives 0x%02x",
+             size, i, (unsigned char)x[i], (unsigned char)y[i]);
+    return 1;
+}
+
+static int check_strlcat(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+    char x[DST_CAP];
+    char y[DST_CAP];
+    size_t size = min_size(in->n, DST_CAP);
+
+    input_strings(in, a, b);
+    memset(x, '#', DST_CAP);
+    memcpy(x, a, strlen(a) + 1);
+    memcpy(y, x, DST_CAP);
+    size_t got = ft_strlcat(x, b, size);
+    size_t want = ref_strlcat(y, b, size);
+    if (got != want)
+        FAIL("ft_strlcat(a, b, %zu) returned %zu, BSD strlcat gives %zu", size, got, want);
+    size_t i = first_diff(x, y, DST_CAP);
+    if (i < DST_CAP)
+        FAIL("ft_strlcat(a, b, %zu): dst[%zu] is 0x%02x, BSD strlcat gives 0x%02x",
+             size, i, (unsigned char)x[i], (unsigned char)y[i]);
+    return 1;
+}
+
+static int check_strnstr(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+
+    input_strings(in, a, b);
+    long got = offset_of(ft_strnstr(a, b, in->n), a);
+    long want = offset_of(ref_strnstr(a, b, in->n), a);
+    if (got != want)
+        FAIL("ft_strnstr(a, b, %zu) returned offset %ld, BSD strnstr gives %ld",
+             in->n, got, want);
+    return 1;
+}
+
+/* --- conversions and ctype ----------------------------------------------- */
+
+/* Values outside int are undefined for atoi(3), so they are skipped */
+static int check_atoi(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+
+    input_strings(in, a, b);
+    errno = 0;
+    long want = strtol(a, NULL, 10);
+    if (errno == ERANGE || want < INT_MIN || want > INT_MAX)
+        return 1;
+    int got = ft_atoi(a);
+    if (got != (int)want)
+        FAIL("ft_atoi(a) returned %d, atoi gives %ld", got, want);
+    return 1;
+}
+
+static int check_itoa(const t_fuzz_input *in, char *why, size_t len) {
+    int v = (int)(unsigned int)in->n;
+    char want[16];
+    char *got = ft_itoa(v);
+
+    snprintf(want, sizeof(want), "%d", v);
+    if (!got)
+        FAIL("ft_itoa(%d) returned NULL", v);
+    int same = strcmp(got, want) == 0;
+    if (!same)
+        snprintf(why, len, "ft_itoa(%d) returned \"%.20s\", expected \"%s\"", v, got, want);
+    free(got);
+    return same;
+}
+
+/* The ctype functions are only defined for EOF and unsigned char values */
+static int ctype_arg(int c) {
+    return (c == EOF || (c >= 0 && c <= 255)) ? c : (unsigned char)c;
+}
+
+#define CHECK_CTYPE(fn) \
+    static int check_##fn(const t_fuzz_input *in, char *why, size_t len) { \
+        int c = ctype_arg(in->c); \
+        int got = ft_##fn(c); \
+        int want = fn(c); \
+        if ((got != 0) != (want != 0)) \
+            FAIL("ft_" #fn "(%d) returned %d, " #fn " gives %d", c, got, want); \
+        return 1; \
+    }
+
+CHECK_CTYPE(isalpha)
+CHECK_CTYPE(isdigit)
+CHECK_CTYPE(isalnum)
+CHECK_CTYPE(isascii)
+CHECK_CTYPE(isprint)
+
+static int check_toupper(const t_fuzz_input *in, char *why, size_t len) {
+    int c = ctype_arg(in->c);
+    int got = ft_toupper(c);
+    if (got != toupper(c))
+        FAIL("ft_toupper(%d) returned %d, toupper gives %d", c, got, toupper(c));
+    return 1;
+}
+
+static int check_tolower(const t_fuzz_input *in, char *why, size_t len) {
+    int c = ctype_arg(in->c);
+    int got = ft_tolower(c);
+    if (got != tolower(c))
+        FAIL("ft_tolower(%d) returned %d, tolower gives %d", c, got, tolower(c));
+    return 1;
+}
+
+/* --- allocating helpers -------------------------------------------------- */
+
+/* Compare an allocated result with the expected string and free it */
+static int expect_string(char *got, const char *want, const char *call, char *why, size_t len) {
+    if (!got)
+        FAIL("%s returned NULL", call);
+    size_t i = first_diff(got, want, strlen(want) + 1);
+    int same = i > strlen(want);
+    if (!same)
+        snprintf(why, len, "%s: byte %zu is 0x%02x, expected 0x%02x", call, i,
+                 (unsigned char)got[i], (unsigned char)want[i]);
+    free(got);
+    return same;
+}
+
+static int check_strdup(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+
+    input_strings(in, a, b);
+    return expect_string(ft_strdup(a), a, "ft_strdup(a)", why, len);
+}
+
+static int check_substr(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+    char want[FUZZ_MAX_LEN + 1] = "";
+    char call[64];
+    unsigned int start = (unsigned int)in->off;
+
+    input_strings(in, a, b);
+    if (start < strlen(a))
+        ref_strlcpy(want, a + start, min_size(in->n, strlen(a) - start) + 1);
+    snprintf(call, sizeof(call), "ft_substr(a, %u, %zu)", start, in->n);
+    return expect_string(ft_substr(a, start, in->n), want, call, why, len);
+}
+
+static int check_strjoin(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+    char want[DST_CAP];
+
+    input_strings(in, a, b);
+    snprintf(want, sizeof(want), "%s%s", a, b);
+    return expect_string(ft_strjoin(a, b), want, "ft_strjoin(a, b)", why, len);
+}
+
+static int check_strtrim(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+    char want[FUZZ_MAX_LEN + 1] = "";
+
+    input_strings(in, a, b);
+    size_t start = 0;
+    size_t end = strlen(a);
+    while (start < end && strchr(b, a[start]))
+        start++;
+    while (end > start && strchr(b, a[end - 1]))
+        end--;
+    ref_strlcpy(want, a + start, end - start + 1);
+    return expect_string(ft_strtrim(a, b), want, "ft_strtrim(a, b)", why, len);
+}
+
+static int check_split(const t_fuzz_input *in, char *why, size_t len) {
+    char a[FUZZ_MAX_LEN + 1];
+    char b[FUZZ_MAX_LEN + 1];
+    char sep = (char)in->c;
+    int ok = 1;
+
+    input_strings(in, a, b);
+    char **words = ft_split(a, sep);
+    if (!words)
+        FAIL("ft_split(a, %d) returned NULL", sep);
+    size_t i = 0;
+    size_t w = 0;
+    const char *s = a;
+    while (ok) {
+        while (*s && *s == sep)
+            s++;
+        if (!*s)
+            break;
+        size_t wlen = 0;
+        while (s[wlen] && s[wlen] != sep)
+            wlen++;
+        if (!words[w] || strlen(words[w]) != wlen || strncmp(words[w], s, wlen) != 0) {
+            snprintf(why, len, "ft_split(a, %d): word %zu is %s%.40s%s, expected \"%.*s\"",
+                     sep, w, words[w] ? "\"" : "", words[w] ? words[w] : "NULL",
+                     words[w] ? "\"" : "", (int)(wlen > 40 ? 40 : wlen), s);
+            ok = 0;
+        }
+        if (words[w])
+            w++;
+        s += wlen;
+    }
+    if (ok && words[w]) {
+        snprintf(why, len, "ft_split(a, %d): extra word %zu \"%.40s\"", sep, w, words[w]);
+        ok = 0;
+    }
+    while (words[i])
+        free(words[i++]);
+    free(words);
+    return ok;
+}
+
+/* Overflowing count * size must fail; sane sizes must give zeroed memory */
+static int check_calloc(const t_fuzz_input *in, char *why, size_t len) {
+    size_t count = in->n;
+    size_t size = in->off;
+    int overflow = size && count > SIZE_MAX / size;
+
+    if (!overflow && count * size > CALLOC_CHECK_MAX)
+        return 1;
+    unsigned char *p = ft_calloc(count, size);
+    if (overflow && p) {
+        free(p);
+        FAIL("ft_calloc(%zu, %zu) overflows but returned non-NULL", count, size);
+    }
+    if (!overflow && count * size > 0 && !p)
+        FAIL("ft_calloc(%zu, %zu) returned NULL", count, size);
+    for (size_t i = 0; p && i < count * size; i++) {
+        if (p[i]) {
+            free(p);
+            FAIL("ft_calloc(%zu, %zu): byte %zu is not zero", count, size, i);
+        }
+    }
+    free(p);
+    return 1;
+}
+
+const t_oracle g_oracles[] = {
+    { "ft_memset",  "mem",   check_memset },
+    { "ft_bzero",   "mem",   check_bzero },
+    { "ft_memcpy",  "mem",   check_memcpy },
+    { "ft_memmove", "mem",   check_memmove },
+    { "ft_memchr",  "mem",   check_memchr },
+    { "ft_memcmp",  "mem",   check_memcmp },
+    { "ft_strlen",  "str",   check_strlen },
+    { "ft_strchr",  "str",   check_strchr },
+    { "ft_strrchr", "str",   check_strrchr },
+    { "ft_strncmp", "str",   check_strncmp },
+    { "ft_strlcpy", "str",   check_strlcpy },
+    { "ft_strlcat", "str",   check_strlcat },
+    { "ft_strnstr", "str",   check_strnstr },
+    { "ft_atoi",    "conv",  check_atoi },
+    { "ft_itoa",    "conv",  check_itoa },
+    { "ft_isalpha", "conv",  check_isalpha },
+    { "ft_isdigit", "conv",  check_isdigit },
+    { "ft_isalnum", "conv",  check_isalnum },
+    { "ft_isascii", "conv",  check_isascii },
+    { "ft_isprint", "conv",  check_isprint },
+    { "ft_toupper", "conv",  check_toupper },
+    { "ft_tolower", "conv",  check_tolower },
+    { "ft_strdup",  "alloc", check_strdup },
+    { "ft_substr",  "alloc", check_substr },
+    { "ft_strjoin", "alloc", check_strjoin },
+    { "ft_strtrim", "alloc", check_strtrim },
+    { "ft_split",   "alloc", check_split },
+    { "ft_calloc",  "alloc", check_calloc },
+};
+const int g_noracles = (int)(sizeof(g_oracles) / sizeof(g_oracles[0]));
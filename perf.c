@@ -0,0 +1,108 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "tester.h"
+
+/*
+ * Hardware counters for --perf, read with perf_event_open around a test
+ * or a benchmark batch. Counters belong to the process that opened them,
+ * so each forked child or pool worker opens its own on first use. Where
+ * the kernel refuses (containers, perf_event_paranoid, VMs without a
+ * PMU), only the clock_gettime() duration is filled in.
+ */
+
+/* The cycle counter leads the group; the others are optional members */
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} g_events[PERF_NCOUNTERS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+};
+
+static pid_t g_owner = 0;
+static int g_fds[PERF_NCOUNTERS] = { -1, -1, -1, -1, -1 };
+static int g_slot[PERF_NCOUNTERS];   /* position in a group read, -1 if not open */
+static int g_nopen = 0;
+static long long g_start_ns = 0;
+
+static int open_event(int i, int group_fd) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = g_events[i].type;
+    attr.config = g_events[i].config;
+    attr.disabled = group_fd < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                       | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+/* (Re)open the counters for the calling process */
+static void open_counters(void) {
+    for (int i = 0; i < PERF_NCOUNTERS; i++) {
+        if (g_fds[i] >= 0 && g_owner == getpid())
+            close(g_fds[i]);
+        g_fds[i] = -1;
+        g_slot[i] = -1;
+    }
+    g_owner = getpid();
+    g_nopen = 0;
+    if ((g_fds[0] = open_event(0, -1)) < 0)
+        return;
+    g_slot[0] = g_nopen++;
+    for (int i = 1; i < PERF_NCOUNTERS; i++) {
+        if ((g_fds[i] = open_event(i, g_fds[0])) >= 0)
+            g_slot[i] = g_nopen++;
+    }
+}
+
+/* Whether counters can be read in this process */
+int perf_available(void) {
+    if (g_owner != getpid())
+        open_counters();
+    return g_nopen > 0;
+}
+
+/* Start counting; pairs with perf_end() in the same process */
+void perf_begin(void) {
+    if (perf_available()) {
+        ioctl(g_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(g_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    g_start_ns = bench_now_ns();
+}
+
+/* Stop counting and store what happened since perf_begin(). Counts are
+ * scaled up if the kernel had to multiplex the group */
+void perf_end(t_perf_stats *out) {
+    long long ns = bench_now_ns() - g_start_ns;
+    uint64_t buf[3 + PERF_NCOUNTERS];
+
+    if (!out)
+        return;
+    memset(out, 0, sizeof(*out));
+    out->ns = ns;
+    if (g_nopen == 0 || g_owner != getpid())
+        return;
+    ioctl(g_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    ssize_t n = read(g_fds[0], buf, sizeof(buf));
+    if (n < (ssize_t)(3 * sizeof(uint64_t)) || buf[0] != (uint64_t)g_nopen || buf[2] == 0)
+        return;
+    double scale = (double)buf[1] / (double)buf[2];
+    for (int i = 0; i < PERF_NCOUNTERS; i++)
+        out->counts[i] = g_slot[i] < 0 ? -1 : (long long)(buf[3 + g_slot[i]] * scale);
+    out->valid = 1;
+}
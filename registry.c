@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fnmatch.h>
+#include "tester.h"
+
+/*
+ * The static test registry (g_registry in main.c) and the filters that
+ * pick a subset of it: --group=GLOB, --test=GLOB, positional globs and
+ * finally --shard=i/N.
+ */
+
+/* Upper bound on N in --shard=i/N */
+#define MAX_SHARDS 4096
+
+/* Append a pattern to one kind of filter; 0 if the list is full */
+int add_filter(const char **list, int *n, const char *pattern) {
+    if (*n >= MAX_FILTERS)
+        return 0;
+    list[(*n)++] = pattern;
+    return 1;
+}
+
+/* Parse --shard=i/N, 1 <= i <= N */
+int parse_shard(const char *s, t_test_filter *f) {
+    char *end;
+    long i = strtol(s, &end, 10);
+    if (end == s || *end != '/')
+        return 0;
+    const char *rest = end + 1;
+    long n = strtol(rest, &end, 10);
+    if (end == rest || *end != '\0' || n < 1 || n > MAX_SHARDS || i < 1 || i > n)
+        return 0;
+    f->shard = (int)i;
+    f->nshards = (int)n;
+    return 1;
+}
+
+static int any_match(const char *const *patterns, int n, const char *s) {
+    for (int i = 0; i < n; i++) {
+        if (fnmatch(patterns[i], s, 0) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* A test matches when every kind of pattern given has a match */
+static int matches(const t_test_entry *t, const t_test_filter *f) {
+    char path[256];
+
+    if (!f)
+        return 1;
+    if (f->ngroups && !any_match(f->groups, f->ngroups, t->group))
+        return 0;
+    if (f->nnames && !any_match(f->names, f->nnames, t->name))
+        return 0;
+    if (f->npaths) {
+        snprintf(path, sizeof(path), "%s/%s", t->group, t->name);
+        if (!any_match(f->paths, f->npaths, t->group) && !any_match(f->paths, f->npaths, path))
+            return 0;
+    }
+    return 1;
+}
+
+/* Fill in the recorded durations found in a JSON report */
+static void load_durations(const char *path, const t_test_entry *tests, int n,
+                           long long *ns) {
+    char *line = NULL;
+    size_t cap = 0;
+    t_json_record r;
+
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "libft_test: %s: no recorded durations, balancing shards by count\n",
+                path);
+        return;
+    }
+    while (getline(&line, &cap, f) > 0) {
+        if (!read_json_record(line, &r))
+            continue;
+        for (int i = 0; i < n; i++) {
+            if (strcmp(tests[i].group, r.function) == 0 && strcmp(tests[i].name, r.name) == 0)
+                ns[i] = r.duration_ns;
+        }
+    }
+    free(line);
+    fclose(f);
+}
+
+/* Longest processing time first: take the selected tests from slowest to
+ * fastest (ties in table order) and give each to the least loaded shard
+ * (ties to the lowest). Every shard computes the same partition and keeps
+ * only its own tests. Tests with no recorded duration weigh the mean of
+ * the known ones, or 1 when none are known. */
+static void keep_shard(const t_test_entry *tests, int n, const t_test_filter *f, char *sel) {
+    long long ns[MAX_TESTS];
+    long long load[MAX_SHARDS] = { 0 };
+    char done[MAX_TESTS] = { 0 };
+    long long known = 0;
+    int nknown = 0;
+
+    for (int i = 0; i < n; i++)
+        ns[i] = -1;
+    if (f->durations_path)
+        load_durations(f->durations_path, tests, n, ns);
+    for (int i = 0; i < n; i++) {
+        if (sel[i] && ns[i] >= 0) {
+            known += ns[i];
+            nknown++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (ns[i] < 0)
+            ns[i] = nknown ? known / nknown : 1;
+    }
+    for (;;) {
+        int next = -1;
+        for (int i = 0; i < n; i++) {
+            if (sel[i] && !done[i] && (next < 0 || ns[i] > ns[next]))
+                next = i;
+        }
+        if (next < 0)
+            break;
+        int shard = 0;
+        for (int s = 1; s < f->nshards; s++) {
+            if (load[s] < load[shard])
+                shard = s;
+        }
+        load[shard] += ns[next];
+        done[next] = 1;
+        sel[next] = shard == f->shard - 1 ? 2 : 1;
+    }
+    for (int i = 0; i < n; i++)
+        sel[i] = sel[i] == 2;
+}
+
+/* Mark the tests to run in `sel` */
+static void select_tests(const t_test_entry *tests, int n, const t_test_filter *f, char *sel) {
+    for (int i = 0; i < n; i++)
+        sel[i] = matches(&tests[i], f);
+    if (f && f->nshards > 1)
+        keep_shard(tests, n, f, sel);
+}
+
+/* Register the selected tests in table order; returns how many */
+int register_tests(const t_test_entry *tests, int n, const t_test_filter *filter) {
+    const char *group = NULL;
+    char sel[MAX_TESTS];
+    int count = 0;
+
+    select_tests(tests, n, filter, sel);
+    for (int i = 0; i < n; i++) {
+        if (!sel[i])
+            continue;
+        if (!group || strcmp(group, tests[i].group) != 0) {
+            group = tests[i].group;
+            print_header(group);
+        }
+        test_uses(safe_test(tests[i].name, tests[i].func), tests[i].uses);
+        count++;
+    }
+    return count;
+}
+
+/* Print the selected tests as "group/name", one per line */
+int list_tests(const t_test_entry *tests, int n, const t_test_filter *filter) {
+    char sel[MAX_TESTS];
+    int count = 0;
+
+    select_tests(tests, n, filter, sel);
+    for (int i = 0; i < n; i++) {
+        if (sel[i]) {
+            printf("%s/%s\n", tests[i].group, tests[i].name);
+            count++;
+        }
+    }
+    return count;
+}
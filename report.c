@@ -0,0 +1,343 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include "tester.h"
+
+/*
+ * Machine-readable result backends: JSON lines, TAP and JUnit XML.
+ * run_tests() feeds every finished test to report_record() in
+ * registration order, whatever the run mode. JSON reports can be read
+ * back, for shard balancing and --merge.
+ */
+
+static t_format g_format = FORMAT_TEXT;
+static FILE *g_out = NULL;
+static long long g_start_ns = 0;
+static int g_count = 0;
+static int g_failures = 0;
+static int g_errors = 0;
+
+/* JUnit needs the totals up front, so testcases are buffered */
+static FILE *g_junit = NULL;
+static char *g_junit_buf = NULL;
+static size_t g_junit_len = 0;
+
+/* Lower-case name of an outcome, as used by every backend */
+const char *outcome_name(t_outcome outcome) {
+    switch (outcome) {
+    case OUTCOME_PASS:     return "pass";
+    case OUTCOME_FAIL:     return "fail";
+    case OUTCOME_SEGFAULT: return "segfault";
+    case OUTCOME_CRASH:    return "crash";
+    case OUTCOME_TIMEOUT:  return "timeout";
+    case OUTCOME_SANITIZER: return "sanitizer";
+    default:               return "pending";
+    }
+}
+
+/* Parse a --format value; returns 0 if unknown */
+int parse_format(const char *s, t_format *out) {
+    static const char *names[] = { "text", "json", "tap", "junit" };
+    for (int i = 0; i < 4; i++) {
+        if (strcmp(s, names[i]) == 0) {
+            *out = (t_format)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; s && *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(f, "\\%c", c);
+        else if (c == '\n')
+            fputs("\\n", f);
+        else if (c == '\t')
+            fputs("\\t", f);
+        else if (c < 0x20 || c == 0x7f)
+            fprintf(f, "\\u%04x", c);
+        else
+            fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+/* XML 1.0 cannot carry most control characters, even escaped */
+static void xml_string(FILE *f, const char *s) {
+    for (; s && *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '&')
+            fputs("&amp;", f);
+        else if (c == '<')
+            fputs("&lt;", f);
+        else if (c == '>')
+            fputs("&gt;", f);
+        else if (c == '"')
+            fputs("&quot;", f);
+        else if (c < 0x20 && c != '\n' && c != '\t' && c != '\r')
+            fputc('?', f);
+        else
+            fputc(c, f);
+    }
+}
+
+/* Short description of why a test did not pass */
+static const char *failure_detail(const t_test *t) {
+    if (t->outcome == OUTCOME_CRASH && WIFSIGNALED(t->status))
+        return strsignal(WTERMSIG(t->status));
+    if (t->outcome == OUTCOME_TIMEOUT && t->start_ns == 0)
+        return "not run before the global timeout";
+    if (t->outcome == OUTCOME_SANITIZER && t->sanitizer)
+        return t->sanitizer;
+    return outcome_name(t->outcome);
+}
+
+/* Start a report in `fmt`, written to `path` or to stdout */
+int report_open(t_format fmt, const char *path) {
+    g_format = fmt;
+    if (fmt == FORMAT_TEXT)
+        return 1;
+    g_out = path ? fopen(path, "w") : stdout;
+    if (!g_out) {
+        perror(path);
+        return 0;
+    }
+    g_start_ns = bench_now_ns();
+    if (fmt == FORMAT_TAP) {
+        fprintf(g_out, "TAP version 13\n");
+        fflush(g_out);
+    }
+    if (fmt == FORMAT_JUNIT) {
+        g_junit = open_memstream(&g_junit_buf, &g_junit_len);
+        if (!g_junit) {
+            perror("libft_test: junit");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void record_json(const t_test *t) {
+    fprintf(g_out, "{\"id\":%d,\"function\":", t->id);
+    json_string(g_out, t->group->name);
+    fprintf(g_out, ",\"name\":");
+    json_string(g_out, t->name);
+    fprintf(g_out, ",\"outcome\":\"%s\",\"duration_ns\":%lld", outcome_name(t->outcome),
+            t->duration_ns);
+    fprintf(g_out, ",\"allocs\":%ld,\"alloc_bytes\":%zu,\"peak_bytes\":%zu"
+                   ",\"leaked_blocks\":%ld,\"leaked_bytes\":%zu",
+            t->alloc.allocs, t->alloc.bytes, t->alloc.peak,
+            t->alloc.leaked_blocks, t->alloc.leaked_bytes);
+    if (t->cached)
+        fprintf(g_out, ",\"cached\":true");
+    if (t->perf.valid) {
+        static const char *names[PERF_NCOUNTERS] = {
+            "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"
+        };
+        for (int i = 0; i < PERF_NCOUNTERS; i++) {
+            if (t->perf.counts[i] >= 0)
+                fprintf(g_out, ",\"%s\":%lld", names[i], t->perf.counts[i]);
+        }
+    }
+    if (t->outcome != OUTCOME_PASS) {
+        fprintf(g_out, ",\"detail\":");
+        json_string(g_out, failure_detail(t));
+    }
+    if (t->output) {
+        fprintf(g_out, ",\"output\":");
+        json_string(g_out, t->output);
+    }
+    fprintf(g_out, "}\n");
+}
+
+static void record_tap(const t_test *t) {
+    fprintf(g_out, "%s %d - %s: %s\n", t->outcome == OUTCOME_PASS ? "ok" : "not ok",
+            g_count, t->group->name, t->name);
+    fprintf(g_out, "  ---\n");
+    fprintf(g_out, "  outcome: %s\n", outcome_name(t->outcome));
+    /* A JSON string is also a valid YAML double-quoted scalar */
+    if (t->outcome != OUTCOME_PASS) {
+        fprintf(g_out, "  detail: ");
+        json_string(g_out, failure_detail(t));
+        fprintf(g_out, "\n");
+    }
+    fprintf(g_out, "  duration_ns: %lld\n", t->duration_ns);
+    fprintf(g_out, "  allocs: %ld\n  alloc_bytes: %zu\n  peak_bytes: %zu\n",
+            t->alloc.allocs, t->alloc.bytes, t->alloc.peak);
+    fprintf(g_out, "  leaked_blocks: %ld\n  leaked_bytes: %zu\n",
+            t->alloc.leaked_blocks, t->alloc.leaked_bytes);
+    fprintf(g_out, "  ...\n");
+}
+
+static void record_junit(const t_test *t) {
+    FILE *f = g_junit;
+
+    fprintf(f, "    <testcase classname=\"");
+    xml_string(f, t->group->name);
+    fprintf(f, "\" name=\"");
+    xml_string(f, t->name);
+    fprintf(f, "\" time=\"%.9f\">\n", t->duration_ns / 1e9);
+    fprintf(f, "      <properties>\n");
+    fprintf(f, "        <property name=\"duration_ns\" value=\"%lld\"/>\n", t->duration_ns);
+    fprintf(f, "        <property name=\"allocs\" value=\"%ld\"/>\n", t->alloc.allocs);
+    fprintf(f, "        <property name=\"alloc_bytes\" value=\"%zu\"/>\n", t->alloc.bytes);
+    fprintf(f, "        <property name=\"peak_bytes\" value=\"%zu\"/>\n", t->alloc.peak);
+    fprintf(f, "        <property name=\"leaked_bytes\" value=\"%zu\"/>\n", t->alloc.leaked_bytes);
+    fprintf(f, "      </properties>\n");
+    if (t->outcome == OUTCOME_FAIL) {
+        fprintf(f, "      <failure message=\"fail\" type=\"fail\"/>\n");
+    } else if (t->outcome != OUTCOME_PASS) {
+        fprintf(f, "      <error message=\"");
+        xml_string(f, failure_detail(t));
+        fprintf(f, "\" type=\"%s\"/>\n", outcome_name(t->outcome));
+    }
+    if (t->output) {
+        fprintf(f, "      <system-out>");
+        xml_string(f, t->output);
+        fprintf(f, "</system-out>\n");
+    }
+    fprintf(f, "    </testcase>\n");
+}
+
+/* Add one finished test to the report */
+void report_record(const t_test *t) {
+    if (!g_out)
+        return;
+    g_count++;
+    g_failures += t->outcome == OUTCOME_FAIL;
+    g_errors += t->outcome != OUTCOME_FAIL && t->outcome != OUTCOME_PASS;
+    if (g_format == FORMAT_JSON)
+        record_json(t);
+    else if (g_format == FORMAT_TAP)
+        record_tap(t);
+    else if (g_format == FORMAT_JUNIT)
+        record_junit(t);
+    /* Forked tests must not inherit unwritten records and flush them again */
+    fflush(g_out);
+}
+
+/* Finish the report: the TAP plan, or the JUnit document around the cases */
+void report_close(void) {
+    if (!g_out)
+        return;
+    if (g_format == FORMAT_TAP)
+        fprintf(g_out, "1..%d\n", g_count);
+    if (g_format == FORMAT_JUNIT) {
+        double secs = (bench_now_ns() - g_start_ns) / 1e9;
+        fclose(g_junit);
+        fprintf(g_out, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+        fprintf(g_out, "<testsuites name=\"libft_test\" tests=\"%d\" failures=\"%d\" "
+                       "errors=\"%d\" time=\"%.6f\">\n", g_count, g_failures, g_errors, secs);
+        fprintf(g_out, "  <testsuite name=\"libft\" tests=\"%d\" failures=\"%d\" "
+                       "errors=\"%d\" time=\"%.6f\">\n", g_count, g_failures, g_errors, secs);
+        fwrite(g_junit_buf, 1, g_junit_len, g_out);
+        fprintf(g_out, "  </testsuite>\n</testsuites>\n");
+        free(g_junit_buf);
+        g_junit_buf = NULL;
+    }
+    if (g_out != stdout)
+        fclose(g_out);
+    else
+        fflush(g_out);
+    g_out = NULL;
+}
+
+/* --- reading JSON reports back ------------------------------------------- */
+
+/* Value of "key" in a record written by record_json(). Inside strings
+ * every quote is escaped, so `,"key":` can only start a real field */
+static const char *json_field(const char *line, const char *key) {
+    size_t klen = strlen(key);
+    for (const char *p = strchr(line, '"'); p; p = strchr(p + 1, '"')) {
+        if ((p == line || p[-1] == ',' || p[-1] == '{') && strncmp(p + 1, key, klen) == 0
+            && p[klen + 1] == '"' && p[klen + 2] == ':')
+            return p + klen + 3;
+    }
+    return NULL;
+}
+
+/* Undo json_string() into `buf`; 0 if the value is not a string */
+static int json_unescape(const char *p, char *buf, size_t len) {
+    size_t n = 0;
+
+    if (!p || *p++ != '"')
+        return 0;
+    while (*p && *p != '"') {
+        char c = *p++;
+        if (c == '\\') {
+            c = *p++;
+            if (c == 'n')
+                c = '\n';
+            else if (c == 't')
+                c = '\t';
+            else if (c == 'u') {
+                int code = 0;
+                /* Exactly four hex digits; a short escape never reaches the NUL */
+                for (int i = 0; i < 4; i++) {
+                    int h = (unsigned char)*p++;
+                    if (!isxdigit(h))
+                        return 0;
+                    code = code * 16 + (isdigit(h) ? h - '0' : tolower(h) - 'a' + 10);
+                }
+                c = (char)code;
+            } else if (c == '\0')
+                return 0;
+        }
+        if (n + 1 < len)
+            buf[n++] = c;
+    }
+    buf[n] = '\0';
+    return *p == '"';
+}
+
+/* Parse one line of a --format=json report; 0 if it is not a result */
+int read_json_record(const char *line, t_json_record *r) {
+    char outcome[16];
+    const char *dur = json_field(line, "duration_ns");
+
+    if (!json_unescape(json_field(line, "function"), r->function, sizeof(r->function))
+        || !json_unescape(json_field(line, "name"), r->name, sizeof(r->name))
+        || !json_unescape(json_field(line, "outcome"), outcome, sizeof(outcome)) || !dur)
+        return 0;
+    r->duration_ns = strtoll(dur, NULL, 10);
+    const char *cached = json_field(line, "cached");
+    r->cached = cached && strncmp(cached, "true", 4) == 0;
+    for (r->outcome = OUTCOME_PASS; r->outcome <= OUTCOME_SANITIZER; r->outcome++) {
+        if (strcmp(outcome, outcome_name(r->outcome)) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* Add up the JSON reports of several shards and print the summary a
+ * single run would have printed */
+int merge_reports(char **paths, int n) {
+    char *line = NULL;
+    size_t cap = 0;
+    t_json_record r;
+
+    for (int i = 0; i < n; i++) {
+        FILE *f = fopen(paths[i], "r");
+        if (!f) {
+            perror(paths[i]);
+            free(line);
+            return 2;
+        }
+        while (getline(&line, &cap, f) > 0) {
+            if (read_json_record(line, &r)) {
+                tally_outcome(r.outcome);
+                g_stats.cached += r.cached;
+            }
+        }
+        fclose(f);
+    }
+    free(line);
+    print_stats();
+    return (g_stats.failed == 0 && g_stats.segfaults == 0 && g_stats.timeouts == 0) ? 0 : 1;
+}
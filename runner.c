@@ -0,0 +1,859 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "tester.h"
+
+t_stats g_stats = {0, 0, 0, 0, 0, 0, 0};
+
+static t_group g_groups[MAX_GROUPS];
+static int g_ngroups = 0;
+static t_test g_tests[MAX_TESTS];
+static int g_ntests = 0;
+static int g_printed = 0;
+static long long g_global_deadline = 0;
+static int g_text = 1;
+
+/* Heap stats written by whichever process ran the test, indexed by id */
+static t_alloc_stats *g_alloc_shared = NULL;
+
+/* Same for hardware counters, when --perf is on */
+static int g_perf = 0;
+static t_perf_stats *g_perf_shared = NULL;
+
+/* Start a new group: its header is printed before its first result */
+void print_header(const char *function_name) {
+    if (g_ngroups >= MAX_GROUPS) {
+        fprintf(stderr, "libft_test: too many test groups (max %d)\n", MAX_GROUPS);
+        exit(2);
+    }
+    g_groups[g_ngroups].name = function_name;
+    g_ngroups++;
+}
+
+/* Print test result */
+void print_result(const char *test_name, int passed, const char *expected, const char *got) {
+    g_stats.total++;
+    if (passed) {
+        printf(GREEN "  ✓ %s" RESET "\n", test_name);
+        g_stats.passed++;
+    } else {
+        printf(RED "  ✗ %s" RESET "\n", test_name);
+        if (expected && got) {
+            printf(YELLOW "    Expected: %s" RESET "\n", expected);
+            printf(YELLOW "    Got:      %s" RESET "\n", got);
+        }
+        g_stats.failed++;
+    }
+}
+
+/* Register a test; it runs later from run_tests() in its own process */
+int safe_test(const char *test_name, int (*test_func)(void)) {
+    if (g_ngroups == 0)
+        print_header("ungrouped");
+    if (g_ntests >= MAX_TESTS) {
+        fprintf(stderr, "libft_test: too many tests (max %d)\n", MAX_TESTS);
+        exit(2);
+    }
+    t_test *t = &g_tests[g_ntests];
+    t->id = g_ntests;
+    t->group = &g_groups[g_ngroups - 1];
+    t->name = test_name;
+    t->func = test_func;
+    t->uses = NULL;
+    t->outcome = OUTCOME_PENDING;
+    t->status = 0;
+    t->output = NULL;
+    t->sanitizer = NULL;
+    t->timeout_ms = 0;
+    t->start_ns = 0;
+    t->duration_ns = 0;
+    memset(&t->alloc, 0, sizeof(t->alloc));
+    memset(&t->perf, 0, sizeof(t->perf));
+    t->cached = 0;
+    return g_ntests++;
+}
+
+/* Record the ft_* functions a registered test calls besides its group's */
+void test_uses(int id, const char *uses) {
+    if (id >= 0 && id < g_ntests)
+        g_tests[id].uses = uses;
+}
+
+/* Number of parallel children used when -j is not given */
+int default_jobs(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/* Map a child's wait status to an outcome */
+static t_outcome classify(int status) {
+    if (WIFSIGNALED(status))
+        return WTERMSIG(status) == SIGSEGV ? OUTCOME_SEGFAULT : OUTCOME_CRASH;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        return OUTCOME_PASS;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == SANITIZER_EXIT && sanitizer_name())
+        return OUTCOME_SANITIZER;
+    return OUTCOME_FAIL;
+}
+
+/* Read back everything written to a capture file so far */
+static char *read_capture(FILE *capture) {
+    if (!capture)
+        return NULL;
+    fflush(capture);
+    off_t size = lseek(fileno(capture), 0, SEEK_END);
+    char *buf = NULL;
+    if (size > 0 && (buf = malloc(size + 1)) != NULL) {
+        ssize_t n = pread(fileno(capture), buf, size, 0);
+        buf[n > 0 ? n : 0] = '\0';
+    }
+    return buf;
+}
+
+/* Record the result of a finished test */
+static void finish_test(t_test *t, t_outcome outcome, int status, FILE *capture) {
+    t->outcome = outcome;
+    t->status = status;
+    t->output = read_capture(capture);
+    if (outcome == OUTCOME_SANITIZER) {
+        t->sanitizer = sanitizer_report(t->output);
+        if (t->output && !*t->output) {
+            free(t->output);
+            t->output = NULL;
+        }
+    }
+    if (g_alloc_shared)
+        t->alloc = g_alloc_shared[t->id];
+    if (g_perf_shared)
+        t->perf = g_perf_shared[t->id];
+    if (t->start_ns)
+        t->duration_ns = bench_now_ns() - t->start_ns;
+}
+
+/* Absolute deadline (ns) of a test started at `start`, 0 if none */
+static long long test_deadline(const t_test *t, long long start) {
+    long long deadline = t->timeout_ms > 0 ? start + t->timeout_ms * 1000000LL : 0;
+    if (g_global_deadline && (!deadline || g_global_deadline < deadline))
+        deadline = g_global_deadline;
+    return deadline;
+}
+
+static int global_expired(void) {
+    return g_global_deadline && bench_now_ns() >= g_global_deadline;
+}
+
+/* Once the global timeout hits, every test that never started times out */
+static void expire_pending(void) {
+    for (int i = 0; i < g_ntests; i++) {
+        if (g_tests[i].outcome == OUTCOME_PENDING && g_tests[i].start_ns == 0)
+            g_tests[i].outcome = OUTCOME_TIMEOUT;
+    }
+}
+
+/* Print a test's heap activity under its result line */
+static void report_alloc(const t_alloc_stats *a) {
+    char bytes[16];
+    char peak[16];
+
+    if (a->allocs == 0)
+        return;
+    format_size(a->bytes, bytes, sizeof(bytes));
+    format_size(a->peak, peak, sizeof(peak));
+    printf(BLUE "    heap: %ld alloc%s, %s, peak %s" RESET, a->allocs,
+           a->allocs == 1 ? "" : "s", bytes, peak);
+    if (a->leaked_blocks > 0) {
+        char leaked[16];
+        format_size(a->leaked_bytes, leaked, sizeof(leaked));
+        printf(YELLOW ", leaked %s in %ld block%s" RESET, leaked, a->leaked_blocks,
+               a->leaked_blocks == 1 ? "" : "s");
+    }
+    if (a->untracked > 0)
+        printf(YELLOW " (%ld not tracked)" RESET, a->untracked);
+    printf("\n");
+}
+
+/* Print a count as 950, 12.3k, 4.56M... */
+static void format_count(long long n, char *buf, size_t len) {
+    if (n >= 10000000000LL)
+        snprintf(buf, len, "%.2fG", n / 1e9);
+    else if (n >= 10000000)
+        snprintf(buf, len, "%.2fM", n / 1e6);
+    else if (n >= 10000)
+        snprintf(buf, len, "%.1fk", n / 1e3);
+    else
+        snprintf(buf, len, "%lld", n);
+}
+
+/* Print a test's hardware counters, or just its time without them */
+static void report_perf(const t_perf_stats *p) {
+    static const char *names[PERF_NCOUNTERS] = {
+        "cycles", "instr", "branch misses", "L1d misses", "LLC misses"
+    };
+    char buf[16];
+
+    if (!p->valid) {
+        printf(BLUE "    perf: %.1f µs (no counters)" RESET "\n", p->ns / 1e3);
+        return;
+    }
+    printf(BLUE "    perf:");
+    for (int i = 0; i < PERF_NCOUNTERS; i++) {
+        if (p->counts[i] < 0)
+            continue;
+        format_count(p->counts[i], buf, sizeof(buf));
+        printf("%s %s %s", i ? "," : "", buf, names[i]);
+        if (i == PERF_INSTRUCTIONS && p->counts[PERF_CYCLES] > 0)
+            printf(" (IPC %.2f)", (double)p->counts[i] / p->counts[PERF_CYCLES]);
+    }
+    printf(RESET "\n");
+}
+
+/* Count a result without printing it, as print_result() would */
+void tally_outcome(t_outcome outcome) {
+    g_stats.total++;
+    if (outcome == OUTCOME_PASS)
+        g_stats.passed++;
+    else
+        g_stats.failed++;
+    g_stats.segfaults += outcome == OUTCOME_SEGFAULT;
+    g_stats.timeouts += outcome == OUTCOME_TIMEOUT;
+    g_stats.sanitizer += outcome == OUTCOME_SANITIZER;
+}
+
+/* Print one finished test, preceded by its group header when it opens one,
+ * and hand it to the machine-readable report */
+static void report_test(const t_test *t) {
+    report_record(t);
+    cache_record(t);
+    g_stats.cached += t->cached;
+    if (!g_text) {
+        tally_outcome(t->outcome);
+        return;
+    }
+    if (t->id == 0 || g_tests[t->id - 1].group != t->group)
+        printf(BOLD CYAN "\n=== Testing %s ===" RESET "\n", t->group->name);
+    if (t->output)
+        fputs(t->output, stdout);
+    switch (t->outcome) {
+    case OUTCOME_SEGFAULT:
+        print_result(t->name, 0, "No segfault", "SEGFAULT");
+        g_stats.segfaults++;
+        break;
+    case OUTCOME_CRASH:
+        print_result(t->name, 0, "No crash", strsignal(WTERMSIG(t->status)));
+        break;
+    case OUTCOME_TIMEOUT: {
+        char limit[64];
+        if (t->start_ns == 0)
+            snprintf(limit, sizeof(limit), "Run before the global timeout");
+        else
+            snprintf(limit, sizeof(limit), "Finish within %ld ms", t->timeout_ms);
+        print_result(t->name, 0, limit, t->start_ns ? "TIMEOUT" : "NOT RUN (TIMEOUT)");
+        g_stats.timeouts++;
+        break;
+    }
+    case OUTCOME_SANITIZER:
+        print_result(t->name, 0, "No sanitizer report",
+                     t->sanitizer ? t->sanitizer : sanitizer_name());
+        g_stats.sanitizer++;
+        break;
+    default:
+        print_result(t->name, t->outcome == OUTCOME_PASS, NULL, NULL);
+        break;
+    }
+    report_alloc(&t->alloc);
+    if (g_perf && !t->cached && t->start_ns)
+        report_perf(&t->perf);
+}
+
+/* Print every finished test that has no unfinished test before it */
+static void flush_reports(void) {
+    while (g_printed < g_ntests && g_tests[g_printed].outcome != OUTCOME_PENDING) {
+        report_test(&g_tests[g_printed]);
+        free(g_tests[g_printed].output);
+        free(g_tests[g_printed].sanitizer);
+        g_tests[g_printed].sanitizer = NULL;
+        g_tests[g_printed++].output = NULL;
+    }
+}
+
+/* Index of the first unfinished test at or after `from` */
+static int next_pending(int from) {
+    while (from < g_ntests && g_tests[from].outcome != OUTCOME_PENDING)
+        from++;
+    return from;
+}
+
+/* Call a test's function with the malloc interposer counting for it */
+static int call_test(const t_test *t) {
+    alloc_begin();
+    if (g_perf)
+        perf_begin();
+    int result = t->func();
+    if (g_perf)
+        perf_end(g_perf_shared ? &g_perf_shared[t->id] : NULL);
+    alloc_end(g_alloc_shared ? &g_alloc_shared[t->id] : NULL);
+    return result;
+}
+
+/* Signal mask of the runner outside run_forked(), restored in children */
+static sigset_t g_child_mask;
+
+static void on_sigchld(int sig) {
+    (void)sig;
+}
+
+/* Fork a child running one test; the exit code carries the result.
+ * The child's stdout goes to `capture` so it can be replayed in order. */
+static pid_t spawn_test(t_test *t, FILE *capture) {
+    fflush(stdout);
+    t->start_ns = bench_now_ns();
+    pid_t pid = fork();
+    if (pid == 0) {
+        signal(SIGCHLD, SIG_DFL);
+        sigprocmask(SIG_SETMASK, &g_child_mask, NULL);
+        if (capture)
+            dup2(fileno(capture), STDOUT_FILENO);
+        int result = call_test(t);
+        exit(result ? 0 : 1);
+    }
+    return pid;
+}
+
+/* Fork mode: one fresh child per unfinished test, up to `jobs` at once.
+ * SIGCHLD is blocked and waited for with a timeout, so a child that
+ * overruns its deadline can be killed and reported as TIMEOUT. */
+static void run_forked(int jobs) {
+    pid_t pids[jobs];
+    int ids[jobs];
+    FILE *captures[jobs];
+    long long deadlines[jobs];
+    int killed[jobs];
+    int active = 0;
+    int next = next_pending(0);
+    struct sigaction sa;
+    struct sigaction old_sa;
+    sigset_t chld;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_sigchld;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGCHLD, &sa, &old_sa);
+    sigemptyset(&chld);
+    sigaddset(&chld, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &chld, &g_child_mask);
+
+    while (g_printed < g_ntests) {
+        if (global_expired()) {
+            for (int i = 0; i < active; i++) {
+                if (!killed[i])
+                    kill(pids[i], SIGKILL);
+                killed[i] = 1;
+            }
+            expire_pending();
+            next = g_ntests;
+        }
+        while (active < jobs && next < g_ntests) {
+            FILE *capture = tmpfile();
+            pid_t pid = spawn_test(&g_tests[next], capture);
+            if (pid < 0) {
+                g_tests[next].start_ns = 0;
+                if (capture)
+                    fclose(capture);
+                if (active > 0)
+                    break;
+                perror("libft_test: fork");
+                exit(2);
+            }
+            pids[active] = pid;
+            ids[active] = next;
+            captures[active] = capture;
+            deadlines[active] = test_deadline(&g_tests[next], g_tests[next].start_ns);
+            killed[active] = 0;
+            next = next_pending(next + 1);
+            active++;
+        }
+
+        if (active == 0) {
+            flush_reports();
+            break;
+        }
+
+        int reaped = 0;
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            for (int i = 0; i < active; i++) {
+                if (pids[i] != pid)
+                    continue;
+                finish_test(&g_tests[ids[i]], killed[i] ? OUTCOME_TIMEOUT : classify(status),
+                            status, captures[i]);
+                if (captures[i])
+                    fclose(captures[i]);
+                active--;
+                pids[i] = pids[active];
+                ids[i] = ids[active];
+                captures[i] = captures[active];
+                deadlines[i] = deadlines[active];
+                killed[i] = killed[active];
+                reaped++;
+                break;
+            }
+        }
+
+        if (!reaped) {
+            /* Kill overdue children, then sleep until the next deadline or exit */
+            long long now = bench_now_ns();
+            long long nearest = 0;
+            for (int i = 0; i < active; i++) {
+                if (killed[i] || !deadlines[i])
+                    continue;
+                if (deadlines[i] <= now) {
+                    kill(pids[i], SIGKILL);
+                    killed[i] = 1;
+                } else if (!nearest || deadlines[i] < nearest) {
+                    nearest = deadlines[i];
+                }
+            }
+            struct timespec ts;
+            if (nearest) {
+                ts.tv_sec = (nearest - now) / 1000000000LL;
+                ts.tv_nsec = (nearest - now) % 1000000000LL;
+            }
+            sigtimedwait(&chld, NULL, nearest ? &ts : NULL);
+        }
+        flush_reports();
+    }
+
+    sigprocmask(SIG_SETMASK, &g_child_mask, NULL);
+    sigaction(SIGCHLD, &old_sa, NULL);
+}
+
+/* A long-lived pool worker and the test it is currently running */
+typedef struct {
+    pid_t pid;
+    int cmd_fd;
+    int res_fd;
+    FILE *capture;
+    int test;
+    long long deadline;
+} t_worker;
+
+/* Worker side: run test IDs read from `cmd_fd` until the pipe closes */
+static void worker_loop(int cmd_fd, int res_fd) {
+    int id;
+    while (read(cmd_fd, &id, sizeof(id)) == (ssize_t)sizeof(id)) {
+        lseek(STDOUT_FILENO, 0, SEEK_SET);
+        if (ftruncate(STDOUT_FILENO, 0) != 0)
+            _exit(3);
+        char result = call_test(&g_tests[id]) ? 1 : 0;
+        fflush(stdout);
+        if (write(res_fd, &result, 1) != 1)
+            _exit(3);
+    }
+    exit(0);
+}
+
+/* Start (or restart) worker `w`; the other workers' pipes are closed in the child */
+static int spawn_worker(t_worker *workers, int count, int w) {
+    int cmd[2];
+    int res[2];
+    t_worker *wk = &workers[w];
+
+    if (pipe(cmd) != 0)
+        return 0;
+    if (pipe(res) != 0) {
+        close(cmd[0]);
+        close(cmd[1]);
+        return 0;
+    }
+    wk->capture = tmpfile();
+    fflush(stdout);
+    wk->pid = fork();
+    if (wk->pid == 0) {
+        for (int i = 0; i < count; i++) {
+            if (i != w && workers[i].pid > 0) {
+                close(workers[i].cmd_fd);
+                close(workers[i].res_fd);
+                if (workers[i].capture)
+                    fclose(workers[i].capture);
+            }
+        }
+        close(cmd[1]);
+        close(res[0]);
+        if (wk->capture)
+            dup2(fileno(wk->capture), STDOUT_FILENO);
+        worker_loop(cmd[0], res[1]);
+    }
+    close(cmd[0]);
+    close(res[1]);
+    if (wk->pid < 0) {
+        close(cmd[1]);
+        close(res[0]);
+        if (wk->capture)
+            fclose(wk->capture);
+        return 0;
+    }
+    wk->cmd_fd = cmd[1];
+    wk->res_fd = res[0];
+    wk->test = -1;
+    wk->deadline = 0;
+    return 1;
+}
+
+/* Tear down a worker: close its pipes and reap it */
+static int stop_worker(t_worker *wk) {
+    int status = 0;
+    close(wk->cmd_fd);
+    close(wk->res_fd);
+    waitpid(wk->pid, &status, 0);
+    if (wk->capture)
+        fclose(wk->capture);
+    wk->pid = -1;
+    return status;
+}
+
+/* Kill a worker stuck in its test, record the timeout and replace it */
+static void timeout_worker(t_worker *workers, int count, int w) {
+    t_worker *wk = &workers[w];
+    FILE *capture = wk->capture;
+
+    kill(wk->pid, SIGKILL);
+    wk->capture = NULL;
+    int status = stop_worker(wk);
+    finish_test(&g_tests[wk->test], OUTCOME_TIMEOUT, status, capture);
+    if (capture)
+        fclose(capture);
+    if (!spawn_worker(workers, count, w)) {
+        perror("libft_test: worker");
+        exit(2);
+    }
+}
+
+/* Pool mode: `jobs` pre-forked workers take test IDs over a pipe.
+ * A worker is only replaced when a test kills it or overruns. */
+static void run_pool(int jobs) {
+    t_worker workers[jobs];
+    struct pollfd fds[jobs];
+    int next = next_pending(0);
+
+    for (int w = 0; w < jobs; w++)
+        workers[w].pid = -1;
+    for (int w = 0; w < jobs; w++) {
+        if (!spawn_worker(workers, jobs, w)) {
+            perror("libft_test: worker");
+            exit(2);
+        }
+    }
+
+    while (g_printed < g_ntests) {
+        if (global_expired()) {
+            for (int w = 0; w < jobs; w++) {
+                if (workers[w].test >= 0)
+                    timeout_worker(workers, jobs, w);
+            }
+            expire_pending();
+            flush_reports();
+            break;
+        }
+
+        int busy = 0;
+        long long now = bench_now_ns();
+        long long nearest = 0;
+        for (int w = 0; w < jobs; w++) {
+            t_worker *wk = &workers[w];
+            if (wk->test < 0 && next < g_ntests) {
+                g_tests[next].start_ns = now;
+                if (write(wk->cmd_fd, &next, sizeof(next)) == (ssize_t)sizeof(next)) {
+                    wk->test = next;
+                    wk->deadline = test_deadline(&g_tests[next], now);
+                    next = next_pending(next + 1);
+                } else {
+                    g_tests[next].start_ns = 0;
+                }
+            }
+            if (wk->test >= 0 && wk->deadline && wk->deadline <= now)
+                timeout_worker(workers, jobs, w);
+            else if (wk->test >= 0 && wk->deadline && (!nearest || wk->deadline < nearest))
+                nearest = wk->deadline;
+            fds[w].fd = wk->test >= 0 ? wk->res_fd : -1;
+            fds[w].events = POLLIN;
+            fds[w].revents = 0;
+            busy += wk->test >= 0;
+        }
+        flush_reports();
+        if (busy == 0) {
+            if (g_printed < g_ntests && next >= g_ntests) {
+                fprintf(stderr, "libft_test: worker pool stalled\n");
+                exit(2);
+            }
+            continue;
+        }
+        int wait_ms = -1;
+        if (nearest)
+            wait_ms = (int)((nearest - now) / 1000000LL) + 1;
+        if (poll(fds, jobs, wait_ms) < 0) {
+            perror("libft_test: poll");
+            exit(2);
+        }
+
+        for (int w = 0; w < jobs; w++) {
+            t_worker *wk = &workers[w];
+            if (wk->test < 0 || !(fds[w].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            t_test *t = &g_tests[wk->test];
+            char result;
+            if (read(wk->res_fd, &result, 1) == 1) {
+                finish_test(t, result ? OUTCOME_PASS : OUTCOME_FAIL, 0, wk->capture);
+                wk->test = -1;
+                continue;
+            }
+            /* The worker died mid-test: record why, then replace it */
+            FILE *capture = wk->capture;
+            wk->capture = NULL;
+            int status = stop_worker(wk);
+            finish_test(t, classify(status), status, capture);
+            if (capture)
+                fclose(capture);
+            if (!spawn_worker(workers, jobs, w)) {
+                perror("libft_test: worker");
+                exit(2);
+            }
+        }
+        flush_reports();
+    }
+
+    for (int w = 0; w < jobs; w++)
+        stop_worker(&workers[w]);
+}
+
+/* In-process mode: where a faulting test jumps back to */
+static sigjmp_buf g_fault_jump;
+static volatile sig_atomic_t g_fault_sig = 0;
+
+static const int g_fault_signals[] = { SIGSEGV, SIGBUS, SIGABRT, SIGFPE, SIGILL, SIGALRM };
+#define NFAULT_SIGNALS (int)(sizeof(g_fault_signals) / sizeof(g_fault_signals[0]))
+
+/* Runs on the alternate stack, so stack overflows are caught too.
+ * SIGALRM is the in-process deadline; it waits for the allocator to
+ * return rather than abandon malloc with its lock held. */
+static void fault_handler(int sig) {
+    if (sig == SIGALRM && alloc_defer(sig))
+        return;
+    g_fault_sig = sig;
+    siglongjmp(g_fault_jump, 1);
+}
+
+/* Install (or, with `on` = 0, remove) the in-process fault handlers */
+static int set_fault_handlers(int on) {
+    static stack_t alt;
+    struct sigaction sa;
+
+    if (on && !alt.ss_sp) {
+        alt.ss_size = SIGSTKSZ > 65536 ? SIGSTKSZ : 65536;
+        alt.ss_sp = malloc(alt.ss_size);
+        if (!alt.ss_sp || sigaltstack(&alt, NULL) != 0)
+            return 0;
+    }
+    memset(&sa, 0, sizeof(sa));
+    sigemptyset(&sa.sa_mask);
+    sa.sa_handler = on ? fault_handler : SIG_DFL;
+    sa.sa_flags = on ? SA_ONSTACK : 0;
+    for (int i = 0; i < NFAULT_SIGNALS; i++)
+        sigaction(g_fault_signals[i], &sa, NULL);
+    return 1;
+}
+
+/* Cheap check that a test left the allocator usable */
+static int heap_usable(void) {
+    if (sigsetjmp(g_fault_jump, 1))
+        return 0;
+    void *p = malloc(64);
+    free(p);
+    return p != NULL;
+}
+
+/* Arm (or with 0, disarm) the one-shot in-process deadline timer */
+static void set_alarm_ns(long long ns) {
+    struct itimerval it;
+    memset(&it, 0, sizeof(it));
+    if (ns > 0) {
+        it.it_value.tv_sec = ns / 1000000000LL;
+        it.it_value.tv_usec = (ns % 1000000000LL) / 1000 + 1;
+    }
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+/* Run one test inside the runner with stdout redirected to `capture`.
+ * Returns 0 if the test faulted and has to be re-run in a child; a test
+ * that overruns its deadline is recorded as TIMEOUT straight away. */
+static int run_in_process(t_test *t, FILE *capture, int saved_stdout) {
+    volatile int result = 0;
+
+    lseek(fileno(capture), 0, SEEK_SET);
+    if (ftruncate(fileno(capture), 0) != 0)
+        return 0;
+    fflush(stdout);
+    dup2(fileno(capture), STDOUT_FILENO);
+    g_fault_sig = 0;
+    t->start_ns = bench_now_ns();
+    long long deadline = test_deadline(t, t->start_ns);
+    if (sigsetjmp(g_fault_jump, 1) == 0) {
+        if (deadline)
+            set_alarm_ns(deadline - t->start_ns);
+        result = call_test(t);
+    }
+    set_alarm_ns(0);
+    alloc_end(NULL);
+    /* A test jumped out of leaves its guard pages behind */
+    if (g_fault_sig)
+        guard_reset();
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    if (g_fault_sig == SIGALRM) {
+        finish_test(t, OUTCOME_TIMEOUT, 0, capture);
+        return 1;
+    }
+    if (g_fault_sig) {
+        t->start_ns = 0;
+        return 0;
+    }
+    finish_test(t, result ? OUTCOME_PASS : OUTCOME_FAIL, 0, capture);
+    return 1;
+}
+
+/* In-process mode: no fork at all for well-behaved tests. A test that
+ * faults is left pending for fork mode, as is everything after a test
+ * that leaves the heap unusable or times out: the test was stopped at an
+ * arbitrary point, possibly holding a lock inside libc. A fault inside
+ * malloc itself leaves its lock held, and fork() takes that lock too, so
+ * the run cannot go on at all. */
+static void run_inprocess(int jobs) {
+    FILE *capture = tmpfile();
+    int saved_stdout = dup(STDOUT_FILENO);
+
+    if (capture && saved_stdout >= 0 && set_fault_handlers(1)) {
+        for (int i = 0; i < g_ntests; i++) {
+            if (global_expired())
+                break;
+            if (g_tests[i].outcome == OUTCOME_PENDING)
+                run_in_process(&g_tests[i], capture, saved_stdout);
+            flush_reports();
+            if (alloc_busy()) {
+                fprintf(stderr, "libft_test: %s / %s crashed inside malloc, cannot go on "
+                                "in-process; run it without --inproc\n",
+                        g_tests[i].group->name, g_tests[i].name);
+                fflush(stdout);
+                _exit(2);
+            }
+            if (g_fault_sig == SIGALRM || !heap_usable())
+                break;
+        }
+        set_fault_handlers(0);
+    }
+    if (capture)
+        fclose(capture);
+    if (saved_stdout >= 0)
+        close(saved_stdout);
+    run_forked(jobs);
+}
+
+/* Per-test time limit for a function: the last matching override wins */
+static long timeout_for(const t_run_config *cfg, const char *function) {
+    long ms = cfg->timeout_ms;
+    for (int i = 0; i < cfg->noverrides; i++) {
+        if (strcmp(cfg->overrides[i].function, function) == 0)
+            ms = cfg->overrides[i].ms;
+    }
+    return ms;
+}
+
+/* Run every registered test with up to `cfg->jobs` tests in flight.
+ * Results are printed in registration order as soon as all earlier
+ * tests have finished, so the report does not depend on scheduling. */
+void run_tests(const t_run_config *cfg) {
+    int jobs = cfg->jobs < 1 ? 1 : cfg->jobs;
+
+    if (jobs > g_ntests)
+        jobs = g_ntests > 0 ? g_ntests : 1;
+    for (int i = 0; i < g_ntests; i++)
+        g_tests[i].timeout_ms = timeout_for(cfg, g_tests[i].group->name);
+    /* Cached tests are already finished: every mode skips them */
+    if (cfg->cache_path && cache_open(cfg->cache_path)) {
+        for (int i = 0; i < g_ntests; i++)
+            cache_lookup(&g_tests[i]);
+    }
+    if (cfg->global_timeout_ms > 0)
+        g_global_deadline = bench_now_ns() + cfg->global_timeout_ms * 1000000LL;
+    if (!report_open(cfg->format, cfg->output_path))
+        exit(2);
+    g_text = cfg->format == FORMAT_TEXT || cfg->output_path;
+    if (g_ntests > 0) {
+        void *shared = mmap(NULL, g_ntests * sizeof(t_alloc_stats), PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        g_alloc_shared = shared == MAP_FAILED ? NULL : shared;
+    }
+    g_perf = cfg->perf;
+    if (g_perf && !perf_available())
+        fprintf(stderr, "libft_test: hardware counters unavailable, --perf shows times only\n");
+    if (g_perf && g_ntests > 0) {
+        void *shared = mmap(NULL, g_ntests * sizeof(t_perf_stats), PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        g_perf_shared = shared == MAP_FAILED ? NULL : shared;
+    }
+    if (cfg->mode == MODE_POOL)
+        run_pool(jobs);
+    else if (cfg->mode == MODE_INPROC)
+        run_inprocess(jobs);
+    else
+        run_forked(jobs);
+    report_close();
+    cache_close();
+    fflush(stdout);
+    if (g_alloc_shared)
+        munmap(g_alloc_shared, g_ntests * sizeof(t_alloc_stats));
+    g_alloc_shared = NULL;
+    if (g_perf_shared)
+        munmap(g_perf_shared, g_ntests * sizeof(t_perf_stats));
+    g_perf_shared = NULL;
+}
+
+/* Print final statistics */
+void print_stats(void) {
+    printf(BOLD CYAN "\n=== TEST SUMMARY ===" RESET "\n");
+    printf("Total tests: %d\n", g_stats.total);
+    printf(GREEN "Passed: %d" RESET "\n", g_stats.passed);
+    printf(RED "Failed: %d" RESET "\n", g_stats.failed);
+    printf(MAGENTA "Segfaults: %d" RESET "\n", g_stats.segfaults);
+    printf(MAGENTA "Timeouts: %d" RESET "\n", g_stats.timeouts);
+    /* A plain build can still --merge reports from sanitizer shards */
+    if (sanitizer_name())
+        printf(MAGENTA "Sanitizer reports (%s): %d" RESET "\n", sanitizer_name(), g_stats.sanitizer);
+    else if (g_stats.sanitizer > 0)
+        printf(MAGENTA "Sanitizer reports: %d" RESET "\n", g_stats.sanitizer);
+    if (g_stats.cached > 0)
+        printf(BLUE "Cached: %d (not re-run, --no-cache to run them)" RESET "\n", g_stats.cached);
+
+    double success_rate = g_stats.total > 0 ?
+        (double)g_stats.passed / g_stats.total * 100 : 0;
+
+    if (success_rate >= 90) {
+        printf(GREEN BOLD "Success rate: %.1f%%" RESET "\n", success_rate);
+    } else if (success_rate >= 70) {
+        printf(YELLOW BOLD "Success rate: %.1f%%" RESET "\n", success_rate);
+    } else {
+        printf(RED BOLD "Success rate: %.1f%%" RESET "\n", success_rate);
+    }
+
+    if (g_stats.segfaults > 0) {
+        printf(RED "\n⚠️  Warning: %d segfault(s) detected! Check your implementations.\n" RESET,
+               g_stats.segfaults);
+    }
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tester.h"
+
+/*
+ * Support for the asan, ubsan and msan builds (make asan/ubsan/msan).
+ * Every sanitizer is told to write its report to stdout, which in a test
+ * child is the capture the runner replays, and to exit with
+ * SANITIZER_EXIT. The runner then reports the test as OUTCOME_SANITIZER
+ * with a one-line summary parsed from the report. Faults are left to the
+ * runner, so a NULL test still shows up as SEGFAULT. Leaks are alloc.c's
+ * job.
+ */
+
+#define STR(x)  #x
+#define XSTR(x) STR(x)
+#define SAN_OPTIONS "log_path=stdout:exitcode=" XSTR(SANITIZER_EXIT) \
+                    ":handle_segv=0:handle_sigbus=0:handle_sigfpe=0:handle_abort=0"
+
+/* Read by each sanitizer runtime at startup; unused in other builds */
+const char *__asan_default_options(void) {
+    return SAN_OPTIONS ":detect_leaks=0";
+}
+
+const char *__ubsan_default_options(void) {
+    return SAN_OPTIONS ":halt_on_error=1:print_stacktrace=1";
+}
+
+const char *__msan_default_options(void) {
+    return SAN_OPTIONS;
+}
+
+/* The sanitizer this tester was built with, NULL for a plain build */
+const char *sanitizer_name(void) {
+#ifdef SANITIZER
+    return SANITIZER;
+#else
+    return NULL;
+#endif
+}
+
+/* Start of the line containing `p` */
+static char *line_start(const char *output, char *p) {
+    while (p > output && p[-1] != '\n')
+        p--;
+    return p;
+}
+
+/* Copy the rest of the line at `p` (at most `len` - 1 bytes) to `buf` */
+static void copy_line(char *buf, size_t len, const char *p) {
+    size_t n = strcspn(p, "\n");
+    if (n >= len)
+        n = len - 1;
+    memcpy(buf, p, n);
+    buf[n] = '\0';
+}
+
+/* "/long/path/ft_substr.c:5 in ft_substr" -> "ft_substr.c:5 in ft_substr" */
+static void shorten_location(char *loc) {
+    char *end = loc + strcspn(loc, " ");
+    char *slash = NULL;
+    for (char *p = loc; p < end; p++) {
+        if (*p == '/')
+            slash = p;
+    }
+    if (slash)
+        memmove(loc, slash + 1, strlen(slash + 1) + 1);
+    size_t n = strlen(loc);
+    if (n >= 3 && strcmp(loc + n - 3, " in") == 0)
+        loc[n - 3] = '\0';
+}
+
+/* Find the sanitizer report in a test's captured output and cut it off,
+ * keeping what the test printed before it. Returns a malloc'ed summary
+ * such as "heap-buffer-overflow at ft_substr.c:5 in ft_substr", or NULL
+ * if there is no report */
+char *sanitizer_report(char *output) {
+    static const char *tools[] = {
+        "ERROR: AddressSanitizer: ", "WARNING: MemorySanitizer: ", "runtime error: "
+    };
+    char kind[160] = "";
+    char where[160] = "";
+    char *start = NULL;
+    char *tool = NULL;
+
+    if (!output)
+        return NULL;
+    for (size_t i = 0; i < sizeof(tools) / sizeof(tools[0]) && !start; i++) {
+        char *p = strstr(output, tools[i]);
+        if (!p)
+            continue;
+        start = line_start(output, p);
+        tool = p;
+        p += strlen(tools[i]);
+        /* UBSan describes the error in words, the others with one token */
+        copy_line(kind, sizeof(kind), p);
+        if (i != 2)
+            kind[strcspn(kind, " ")] = '\0';
+    }
+    if (!start)
+        return NULL;
+
+    /* "SUMMARY: AddressSanitizer: <kind> <file:line> in <function>" */
+    char *summary = strstr(start, "SUMMARY: ");
+    if (summary) {
+        char *p = strchr(summary + 9, ':');
+        if (p) {
+            p += 2 + strcspn(p + 2, " \n");
+            if (*p == ' ')
+                copy_line(where, sizeof(where), p + 1);
+        }
+    }
+    /* GCC's UBSan has no summary: "<file:line:col>: runtime error: ..."
+     * and the function from the first stack frame, "#0 0x... in <function>" */
+    if (!where[0] && tool > start + 2) {
+        size_t n = (size_t)(tool - start) - 2;
+        copy_line(where, n + 1 < sizeof(where) ? n + 1 : sizeof(where), start);
+        char *frame = strstr(tool, "#0 ");
+        char *in = frame ? strstr(frame, " in ") : NULL;
+        if (in && in < frame + strcspn(frame, "\n")) {
+            size_t len = strlen(where);
+            snprintf(where + len, sizeof(where) - len, " in %.*s", (int)strcspn(in + 4, " \n"), in + 4);
+        }
+    }
+    shorten_location(where);
+
+    /* ASan opens its report with a line of '=' */
+    if (start > output) {
+        char *prev = line_start(output, start - 1);
+        if (*prev == '=')
+            start = prev;
+    }
+    *start = '\0';
+
+    size_t len = strlen(kind) + strlen(where) + 5;
+    char *r = malloc(len);
+    if (r)
+        snprintf(r, len, where[0] ? "%s at %s" : "%s", kind, where);
+    return r;
+}
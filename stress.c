@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "tester.h"
+
+/* Sweep parameters */
+#define STRESS_MIN_SIZE    (1UL << 20)
+#define STRESS_CASE_LIMIT  120          /* seconds before one case is killed */
+#define STRESS_MEM_SHARE   0.8          /* fraction of free RAM a case may use */
+
+/* One stressed function: `buffers` n-byte mappings, timed call, check */
+typedef struct {
+    const char *name;
+    int buffers;
+    int (*run)(char *a, char *b, size_t n, long long *ns);
+} t_stress;
+
+/* Deterministic, non-periodic-looking byte pattern */
+static unsigned char pattern(size_t i) {
+    return (unsigned char)(i * 131 + (i >> 8) * 7 + (i >> 16) + 1);
+}
+
+static void fill_pattern(char *p, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        p[i] = (char)pattern(i);
+}
+
+/* True when all n bytes of p equal c */
+static int all_bytes(const char *p, size_t n, char c) {
+    return n == 0 || (p[0] == c && memcmp(p, p + 1, n - 1) == 0);
+}
+
+static int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+/* Time a single statement into *ns */
+#define TIMED(ns, stmt) do { \
+        long long t0_ = bench_now_ns(); \
+        stmt; \
+        *(ns) = bench_now_ns() - t0_; \
+    } while (0)
+
+static int stress_memset(char *a, char *b, size_t n, long long *ns) {
+    void *r;
+    (void)b;
+    TIMED(ns, r = ft_memset(a, 'x', n));
+    return r == a && all_bytes(a, n, 'x');
+}
+
+static int stress_bzero(char *a, char *b, size_t n, long long *ns) {
+    (void)b;
+    memset(a, 'x', n);
+    TIMED(ns, ft_bzero(a, n));
+    return all_bytes(a, n, '\0');
+}
+
+static int stress_memcpy(char *a, char *b, size_t n, long long *ns) {
+    void *r;
+    fill_pattern(b, n);
+    TIMED(ns, r = ft_memcpy(a, b, n));
+    return r == a && memcmp(a, b, n) == 0;
+}
+
+static int stress_memmove_up(char *a, char *b, size_t n, long long *ns) {
+    (void)b;
+    fill_pattern(a, n);
+    TIMED(ns, ft_memmove(a + 1, a, n - 1));
+    for (size_t i = 0; i + 1 < n; i++) {
+        if ((unsigned char)a[i + 1] != pattern(i))
+            return 0;
+    }
+    return 1;
+}
+
+static int stress_memmove_down(char *a, char *b, size_t n, long long *ns) {
+    (void)b;
+    fill_pattern(a, n);
+    TIMED(ns, ft_memmove(a, a + 1, n - 1));
+    for (size_t i = 0; i + 1 < n; i++) {
+        if ((unsigned char)a[i] != pattern(i + 1))
+            return 0;
+    }
+    return 1;
+}
+
+static int stress_memchr(char *a, char *b, size_t n, long long *ns) {
+    void *r;
+    (void)b;
+    memset(a, 'a', n);
+    a[n - 1] = (char)0xC8;
+    TIMED(ns, r = ft_memchr(a, 0xC8, n));
+    return r == a + n - 1;
+}
+
+static int stress_memcmp(char *a, char *b, size_t n, long long *ns) {
+    int r;
+    fill_pattern(a, n);
+    memcpy(b, a, n);
+    b[n - 1] = (char)(a[n - 1] + 1);
+    TIMED(ns, r = ft_memcmp(a, b, n));
+    return sign(r) == sign(memcmp(a, b, n));
+}
+
+static int stress_strlen(char *a, char *b, size_t n, long long *ns) {
+    size_t r;
+    (void)b;
+    memset(a, 'a', n - 1);
+    a[n - 1] = '\0';
+    TIMED(ns, r = ft_strlen(a));
+    return r == n - 1;
+}
+
+static int stress_strchr(char *a, char *b, size_t n, long long *ns) {
+    char *r;
+    (void)b;
+    memset(a, 'a', n - 1);
+    a[n - 2] = 'z';
+    a[n - 1] = '\0';
+    TIMED(ns, r = ft_strchr(a, 'z'));
+    return r == a + n - 2;
+}
+
+static int stress_strrchr(char *a, char *b, size_t n, long long *ns) {
+    char *r;
+    (void)b;
+    memset(a, 'a', n - 1);
+    a[0] = 'z';
+    a[n - 1] = '\0';
+    TIMED(ns, r = ft_strrchr(a, 'z'));
+    return r == a;
+}
+
+static int stress_strncmp(char *a, char *b, size_t n, long long *ns) {
+    int r;
+    memset(a, 'a', n - 1);
+    a[n - 1] = '\0';
+    memcpy(b, a, n);
+    b[n - 2] = 'b';
+    TIMED(ns, r = ft_strncmp(a, b, n));
+    return sign(r) == sign(strncmp(a, b, n));
+}
+
+static int stress_strlcpy(char *a, char *b, size_t n, long long *ns) {
+    size_t r;
+    memset(b, 's', n - 1);
+    b[n - 1] = '\0';
+    TIMED(ns, r = ft_strlcpy(a, b, n));
+    return r == n - 1 && memcmp(a, b, n) == 0;
+}
+
+static int stress_strlcat(char *a, char *b, size_t n, long long *ns) {
+    size_t r;
+    size_t half = n / 2;
+    memset(a, 'a', half);
+    a[half] = '\0';
+    memset(b, 'b', half - 1);
+    b[half - 1] = '\0';
+    TIMED(ns, r = ft_strlcat(a, b, n));
+    return r == 2 * half - 1 && all_bytes(a, half, 'a')
+        && all_bytes(a + half, half - 1, 'b') && a[2 * half - 1] == '\0';
+}
+
+static int stress_strnstr(char *a, char *b, size_t n, long long *ns) {
+    char *r;
+    (void)b;
+    memset(a, 'a', n - 1);
+    a[n - 2] = 'b';
+    a[n - 1] = '\0';
+    TIMED(ns, r = ft_strnstr(a, "ab", n));
+    return r == a + n - 3;
+}
+
+static int stress_strdup(char *a, char *b, size_t n, long long *ns) {
+    char *r;
+    (void)b;
+    fill_pattern(a, n - 1);
+    for (size_t i = 0; i + 1 < n; i++)
+        if (a[i] == '\0')
+            a[i] = 'z';
+    a[n - 1] = '\0';
+    TIMED(ns, r = ft_strdup(a));
+    int ok = r && memcmp(r, a, n) == 0;
+    free(r);
+    return ok;
+}
+
+static int stress_substr(char *a, char *b, size_t n, long long *ns) {
+    char *r;
+    (void)b;
+    memset(a, 's', n - 1);
+    a[0] = 'x';
+    a[n - 1] = '\0';
+    TIMED(ns, r = ft_substr(a, 1, n));
+    int ok = r && memcmp(r, a + 1, n - 1) == 0;
+    free(r);
+    return ok;
+}
+
+static int stress_strjoin(char *a, char *b, size_t n, long long *ns) {
+    char *r;
+    memset(a, 'a', n - 1);
+    a[n - 1] = '\0';
+    memset(b, 'b', n - 1);
+    b[n - 1] = '\0';
+    TIMED(ns, r = ft_strjoin(a, b));
+    int ok = r && all_bytes(r, n - 1, 'a') && all_bytes(r + n - 1, n - 1, 'b')
+        && r[2 * n - 2] == '\0';
+    free(r);
+    return ok;
+}
+
+static int stress_calloc(char *a, char *b, size_t n, long long *ns) {
+    char *r;
+    (void)a;
+    (void)b;
+    TIMED(ns, r = ft_calloc(n, 1));
+    int ok = r && all_bytes(r, n, '\0');
+    free(r);
+    return ok;
+}
+
+/* Buffer counts include room for what allocating functions return */
+static const t_stress g_stress[] = {
+    { "ft_memset",       1, stress_memset },
+    { "ft_bzero",        1, stress_bzero },
+    { "ft_memcpy",       2, stress_memcpy },
+    { "ft_memmove (up)",   1, stress_memmove_up },
+    { "ft_memmove (down)", 1, stress_memmove_down },
+    { "ft_memchr",       1, stress_memchr },
+    { "ft_memcmp",       2, stress_memcmp },
+    { "ft_strlen",       1, stress_strlen },
+    { "ft_strchr",       1, stress_strchr },
+    { "ft_strrchr",      1, stress_strrchr },
+    { "ft_strncmp",      2, stress_strncmp },
+    { "ft_strlcpy",      2, stress_strlcpy },
+    { "ft_strlcat",      2, stress_strlcat },
+    { "ft_strnstr",      1, stress_strnstr },
+    { "ft_strdup",       2, stress_strdup },
+    { "ft_substr",       2, stress_substr },
+    { "ft_strjoin",      4, stress_strjoin },
+    { "ft_calloc",       1, stress_calloc },
+};
+#define NSTRESS (int)(sizeof(g_stress) / sizeof(g_stress[0]))
+
+/* Lazily committed anonymous mapping; never counted against swap */
+static char *stress_map(size_t n) {
+    void *p = mmap(NULL, n, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return p == MAP_FAILED ? NULL : p;
+}
+
+/* Free physical memory in bytes, or 0 if unknown */
+static size_t free_memory(void) {
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long page = sysconf(_SC_PAGESIZE);
+    return pages > 0 && page > 0 ? (size_t)pages * (size_t)page : 0;
+}
+
+/* One function at one size; runs in a child and prints its own row */
+static int stress_case(const t_stress *s, size_t n, const char *size_str) {
+    char *a = stress_map(n);
+    char *b = s->buffers > 1 ? stress_map(n) : NULL;
+    long long ns = 0;
+
+    if (!a || (s->buffers > 1 && !b)) {
+        printf(YELLOW "  %-18s %8s  SKIP (mmap failed)" RESET "\n", s->name, size_str);
+        return 0;
+    }
+    int ok = s->run(a, b, n, &ns);
+    double gbps = ns > 0 ? (double)n / (double)ns : 0;
+    if (ok)
+        printf(GREEN "  %-18s %8s  ✓" RESET " %10.3f ms %8.2f GB/s\n",
+               s->name, size_str, ns / 1e6, gbps);
+    else
+        printf(RED "  %-18s %8s  ✗ result differs from libc" RESET " %10.3f ms %8.2f GB/s\n",
+               s->name, size_str, ns / 1e6, gbps);
+    fflush(stdout);
+    return ok ? 0 : 1;
+}
+
+/* Drive every mem/str function with 1 MiB .. max_size buffers */
+int run_stress(const t_bench_config *cfg) {
+    int failed = 0;
+
+    printf(BOLD CYAN "\n=== Stress tier (1 MiB .. huge buffers) ===" RESET "\n");
+    for (int i = 0; i < NSTRESS; i++) {
+        const t_stress *s = &g_stress[i];
+        if (cfg->only && strncmp(cfg->only, s->name, strlen(cfg->only)) != 0)
+            continue;
+        for (size_t n = STRESS_MIN_SIZE; n <= cfg->stress_max; n *= 4) {
+            char size_str[16];
+            format_size(n, size_str, sizeof(size_str));
+
+            size_t avail = free_memory();
+            if (avail && (double)n * s->buffers > avail * STRESS_MEM_SHARE) {
+                printf(YELLOW "  %-18s %8s  SKIP (needs %d x %s, not enough free RAM)" RESET "\n",
+                       s->name, size_str, s->buffers, size_str);
+                break;
+            }
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid == 0) {
+                alarm(STRESS_CASE_LIMIT);
+                exit(stress_case(s, n, size_str));
+            }
+            int status = 0;
+            if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+                perror("libft_test: stress");
+                failed++;
+                break;
+            }
+            if (WIFSIGNALED(status)) {
+                int sig = WTERMSIG(status);
+                printf(RED "  %-18s %8s  ✗ %s" RESET "\n", s->name, size_str,
+                       sig == SIGALRM ? "TIMEOUT" : (sig == SIGSEGV ? "SEGFAULT" : strsignal(sig)));
+                failed++;
+                break;
+            }
+            if (WEXITSTATUS(status) != 0) {
+                failed++;
+                break;
+            }
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,337 @@
+#ifndef TESTER_H
+#define TESTER_H
+
+#include <stddef.h>
+#include <sys/types.h>
+#include "libft/libft.h"
+
+/* Color codes for output */
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+#define RESET   "\033[0m"
+#define BOLD    "\033[1m"
+
+/* Upper bounds for the test tables */
+#define MAX_GROUPS 64
+#define MAX_TESTS  512
+
+/* Final state of a single test */
+typedef enum {
+    OUTCOME_PENDING,
+    OUTCOME_PASS,
+    OUTCOME_FAIL,
+    OUTCOME_SEGFAULT,
+    OUTCOME_CRASH,
+    OUTCOME_TIMEOUT,
+    OUTCOME_SANITIZER             /* a sanitizer build reported an error */
+} t_outcome;
+
+/* Test statistics */
+typedef struct {
+    int total;
+    int passed;
+    int failed;
+    int segfaults;
+    int timeouts;
+    int sanitizer;
+    int cached;
+} t_stats;
+
+/* A function under test, printed as a header before its tests */
+typedef struct {
+    const char *name;
+} t_group;
+
+/* One entry of the static test registry, written with REGISTER_TEST() */
+typedef struct {
+    const char *group;
+    const char *name;
+    int (*func)(void);
+    const char *uses;             /* other ft_* functions it calls, space-separated */
+} t_test_entry;
+
+#define REGISTER_TEST(group, name, func) { group, name, func, NULL }
+#define REGISTER_TEST_USES(group, name, func, uses) { group, name, func, uses }
+
+/* Shell globs selecting registered tests. Each kind given must have at
+ * least one match; paths match "group" or "group/name" */
+#define MAX_FILTERS 32
+
+typedef struct {
+    const char *groups[MAX_FILTERS];
+    int ngroups;
+    const char *names[MAX_FILTERS];
+    int nnames;
+    const char *paths[MAX_FILTERS];
+    int npaths;
+    int shard;                    /* 1..nshards, after the globs */
+    int nshards;                  /* 0 for no sharding */
+    const char *durations_path;   /* JSON report used to balance shards */
+} t_test_filter;
+
+/* Heap activity of one test, as seen by the malloc interposer */
+typedef struct {
+    long allocs;
+    long frees;
+    size_t bytes;
+    size_t peak;
+    long leaked_blocks;
+    size_t leaked_bytes;
+    long untracked;
+    long failed;
+} t_alloc_stats;
+
+/* Hardware counters of one test or benchmark batch, for --perf */
+enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_NCOUNTERS
+};
+
+typedef struct {
+    int valid;                          /* counts[] were read, not just the clock */
+    long long ns;
+    long long counts[PERF_NCOUNTERS];   /* -1 for a counter the CPU lacks */
+} t_perf_stats;
+
+/* A registered test and, once run, its result */
+typedef struct {
+    int id;
+    const t_group *group;
+    const char *name;
+    int (*func)(void);
+    const char *uses;             /* from REGISTER_TEST_USES(), for the cache key */
+    t_outcome outcome;
+    int status;
+    char *output;
+    char *sanitizer;              /* summary of the report, for OUTCOME_SANITIZER */
+    long timeout_ms;
+    long long start_ns;
+    long long duration_ns;
+    t_alloc_stats alloc;
+    t_perf_stats perf;
+    int cached;                   /* result read from the --cache file */
+} t_test;
+
+/* How run_tests() isolates tests from the runner */
+typedef enum {
+    MODE_FORK,
+    MODE_POOL,
+    MODE_INPROC
+} t_run_mode;
+
+/* One result read back from a --format=json report */
+typedef struct {
+    char function[128];
+    char name[256];
+    t_outcome outcome;
+    long long duration_ns;
+    int cached;                   /* "cached":true */
+} t_json_record;
+
+/* Where results go: colored text, or one of the machine formats */
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_JSON,
+    FORMAT_TAP,
+    FORMAT_JUNIT
+} t_format;
+
+/* Per-test time limits: a default plus per-function overrides */
+#define DEFAULT_TIMEOUT_MS     5000
+#define MAX_TIMEOUT_OVERRIDES  64
+
+typedef struct {
+    const char *function;
+    long ms;
+} t_timeout_override;
+
+typedef struct {
+    int jobs;
+    t_run_mode mode;
+    long timeout_ms;
+    long global_timeout_ms;
+    t_timeout_override overrides[MAX_TIMEOUT_OVERRIDES];
+    int noverrides;
+    t_format format;
+    const char *output_path;
+    const char *cache_path;       /* NULL to run every test */
+    int perf;                     /* read hardware counters around each test */
+} t_run_config;
+
+/* Benchmark, complexity and stress mode settings */
+#define BENCH_MAX_SIZE  (64UL << 20)
+#define STRESS_MAX_SIZE (1UL << 30)
+
+typedef struct {
+    size_t max_size;
+    const char *csv_path;
+    const char *only;
+    size_t stress_max;
+    int perf;
+} t_bench_config;
+
+/* Differential fuzzing: one generated input, the checks run on it, and
+ * the fuzzer's budget */
+#define FUZZ_MAX_LEN 512
+
+typedef struct {
+    unsigned char a[FUZZ_MAX_LEN + 1];
+    size_t alen;
+    unsigned char b[FUZZ_MAX_LEN + 1];
+    size_t blen;
+    size_t n;
+    size_t off;
+    int c;
+} t_fuzz_input;
+
+/* Compares one ft_* function with its reference; 0 and a reason on mismatch */
+typedef struct {
+    const char *name;
+    const char *family;
+    int (*check)(const t_fuzz_input *in, char *why, size_t len);
+} t_oracle;
+
+#define FUZZ_DEFAULT_ITERS 20000
+
+typedef struct {
+    long iters;
+    long time_ms;
+    unsigned long seed;
+    const char *only;
+    int jobs;
+} t_fuzz_config;
+
+extern t_stats g_stats;
+
+/* runner.c */
+void print_header(const char *function_name);
+void print_result(const char *test_name, int passed, const char *expected, const char *got);
+int  safe_test(const char *test_name, int (*test_func)(void));
+void test_uses(int id, const char *uses);
+int  default_jobs(void);
+void run_tests(const t_run_config *cfg);
+void tally_outcome(t_outcome outcome);
+void print_stats(void);
+
+/* registry.c */
+int  add_filter(const char **list, int *n, const char *pattern);
+int  parse_shard(const char *s, t_test_filter *f);
+int  register_tests(const t_test_entry *tests, int n, const t_test_filter *filter);
+int  list_tests(const t_test_entry *tests, int n, const t_test_filter *filter);
+
+/* report.c */
+const char *outcome_name(t_outcome outcome);
+int  parse_format(const char *s, t_format *out);
+int  report_open(t_format fmt, const char *path);
+void report_record(const t_test *t);
+void report_close(void);
+int  read_json_record(const char *line, t_json_record *r);
+int  merge_reports(char **paths, int n);
+
+/* cache.c */
+#define DEFAULT_CACHE_FILE ".libft_test_cache"
+int  cache_open(const char *path);
+int  cache_lookup(t_test *t);
+void cache_record(const t_test *t);
+void cache_close(void);
+
+/* guard.c */
+typedef enum {
+    GUARD_TAIL,                   /* the buffer ends at a guard page */
+    GUARD_HEAD                    /* the buffer starts at a guard page */
+} t_guard_edge;
+
+void *guard_alloc(size_t n, t_guard_edge edge);
+char *guard_strdup(const char *s);
+void *guard_memdup(const void *src, size_t n);
+void guard_free(void *p);
+void guard_reset(void);
+
+/* capture.c: where an ft_put*_fd test writes, and what it wrote */
+typedef struct {
+    int fd;
+    long writes;                  /* write(2) calls in between, -1 if unknown */
+    char *data;
+    size_t len;
+} t_capture;
+
+int  capture_begin(t_capture *c);
+int  capture_end(t_capture *c);
+void capture_free(t_capture *c);
+
+/* io.c: write() calls seen by the interposer between io_begin() and io_end() */
+#define IO_MAX_SIZES 8
+
+typedef struct {
+    long writes;
+    size_t bytes;
+    size_t min;
+    size_t max;
+    size_t sizes[IO_MAX_SIZES];   /* the first IO_MAX_SIZES calls */
+} t_io_stats;
+
+void io_begin(void);
+void io_end(t_io_stats *out);
+int  run_io_profile(const t_bench_config *cfg);
+
+/* sanitize.c: asan/ubsan/msan builds exit with this after a report */
+#define SANITIZER_EXIT 86
+
+const char *sanitizer_name(void);
+char *sanitizer_report(char *output);
+
+/* alloc.c */
+int  alloc_busy(void);
+int  alloc_defer(int sig);
+void alloc_begin(void);
+void alloc_end(t_alloc_stats *out);
+void alloc_fail_at(long n);
+
+/* perf.c */
+int  perf_available(void);
+void perf_begin(void);
+void perf_end(t_perf_stats *out);
+
+/* bench.c */
+long long bench_now_ns(void);
+void bench_summarize(double *samples, int n, double *median, double *p99);
+void format_size(size_t n, char *buf, size_t len);
+int  run_benchmarks(const t_bench_config *cfg);
+int  run_vector_report(const t_bench_config *cfg);
+int  run_bench_matrix(char **paths, int n);
+
+/* complexity.c: a fitted exponent up to LINEAR is linear, from QUADRATIC on it is flagged */
+#define CPLX_LINEAR       1.3
+#define CPLX_QUADRATIC    1.7
+
+double fit_exponent(const double *sizes, const double *times, int n);
+int  run_complexity(const t_bench_config *cfg);
+
+/* stress.c */
+int  run_stress(const t_bench_config *cfg);
+
+/* lst.c (BONUS=1 builds) */
+int  run_lst_bench(const t_bench_config *cfg);
+
+/* failinject.c */
+int  run_failinject(const t_run_config *cfg, const char *only);
+
+/* oracle.c */
+extern const t_oracle g_oracles[];
+extern const int g_noracles;
+size_t ref_strlcpy(char *dst, const char *src, size_t size);
+size_t ref_strlcat(char *dst, const char *src, size_t size);
+char *ref_strnstr(const char *hay, const char *needle, size_t n);
+
+/* fuzz.c */
+int  run_fuzz(const t_fuzz_config *cfg);
+
+#endif